@@ -393,6 +393,34 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_solver_export_learned(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_export_learned(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        std::ofstream out(file_name, std::ios::binary);
+        if (!out) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        to_solver_ref(s)->export_learned(out);
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_solver_import_learned(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_import_learned(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        std::ifstream in(file_name, std::ios::binary);
+        if (!in) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        to_solver_ref(s)->import_learned(in);
+        Z3_CATCH;
+    }
+
     Z3_string Z3_API Z3_solver_get_help(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_help(c, s);
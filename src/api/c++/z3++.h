@@ -2994,6 +2994,8 @@ namespace z3 {
         }
         void from_file(char const* file) { Z3_solver_from_file(ctx(), m_solver, file); ctx().check_parser_error(); }
         void from_string(char const* s) { Z3_solver_from_string(ctx(), m_solver, s); ctx().check_parser_error(); }
+        void export_learned(char const* file) { Z3_solver_export_learned(ctx(), m_solver, file); check_error(); }
+        void import_learned(char const* file) { Z3_solver_import_learned(ctx(), m_solver, file); check_error(); }
 
         check_result check() { Z3_lbool r = Z3_solver_check(ctx(), m_solver); check_error(); return to_check_result(r); }
         check_result check(unsigned n, expr * const assumptions) {
@@ -7872,6 +7872,15 @@ class Solver(Z3PPObject):
         """Parse assertions from a string"""
         Z3_solver_from_string(self.ctx.ref(), self.solver, s)
 
+    def export_learned(self, filename):
+        """Save the learned clauses of the solver to a file.
+        They can be loaded with import_learned into a solver with the same assertions."""
+        Z3_solver_export_learned(self.ctx.ref(), self.solver, filename)
+
+    def import_learned(self, filename):
+        """Load learned clauses saved by export_learned. They are used by the next check."""
+        Z3_solver_import_learned(self.ctx.ref(), self.solver, filename)
+
     def cube(self, vars=None):
         """Get set of cubes
         The method takes an optional set of variables that restrict which
@@ -7241,6 +7241,35 @@ extern "C" {
     */
     void Z3_API Z3_solver_from_string(Z3_context c, Z3_solver s, Z3_string str);
 
+    /**
+       \brief Save the learned clauses of the solver to a binary file.
+
+       Only clauses over atoms that are visible to the user are saved, together
+       with the activities and saved phases of these atoms. Clauses learned
+       inside scopes created by #Z3_solver_push are not saved.
+       The file can be loaded with #Z3_solver_import_learned into a solver
+       that has the same assertions, for example after a restart of the process.
+
+       \sa Z3_solver_import_learned
+
+       def_API('Z3_solver_export_learned', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_export_learned(Z3_context c, Z3_solver s, Z3_string file_name);
+
+    /**
+       \brief Load learned clauses saved by #Z3_solver_export_learned.
+
+       The clauses are added by the next check, after the assertions of \c s have
+       been processed. Clauses that use atoms not occurring in \c s are dropped.
+       Learned clauses cannot be imported when proofs are enabled or when
+       \c s has scopes created by #Z3_solver_push.
+
+       \sa Z3_solver_export_learned
+
+       def_API('Z3_solver_import_learned', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_import_learned(Z3_context c, Z3_solver s, Z3_string file_name);
+
     /**
        \brief Return the set of asserted formulas on the solver.
 
@@ -96,5 +96,166 @@ float cost_evaluator::operator()(expr * f, unsigned num_args, float const * args
     return eval(f);
 }
 
+unsigned cost_evaluator::emit(program & p, program::opcode op, unsigned arg, float val) {
+    p.m_code.push_back({ op, arg, val });
+    return p.m_code.size() - 1;
+}
+
+/**
+   \brief Emit code that pushes the value of f on a stack that contains depth values.
+*/
+void cost_evaluator::compile(expr * f, program & p, unsigned depth) {
+    typedef program P;
+    p.m_max_stack = std::max(p.m_max_stack, depth + 2);
+    auto arg = [&](unsigned i) { return to_app(f)->get_arg(i); };
+    auto binary = [&](P::opcode op) {
+        compile(arg(0), p, depth);
+        compile(arg(1), p, depth + 1);
+        emit(p, op);
+    };
+    if (is_app(f)) {
+        family_id fid = to_app(f)->get_family_id();
+        if (fid == m.get_basic_family_id()) {
+            switch (to_app(f)->get_decl_kind()) {
+            case OP_TRUE:     emit(p, P::PUSH, 0, 1.0f); return;
+            case OP_FALSE:    emit(p, P::PUSH, 0, 0.0f); return;
+            case OP_NOT:      compile(arg(0), p, depth); emit(p, P::NOT); return;
+            case OP_AND:
+            case OP_OR: {
+                bool is_and = to_app(f)->get_decl_kind() == OP_AND;
+                unsigned_vector jumps;
+                for (expr * a : *to_app(f)) {
+                    compile(a, p, depth);
+                    jumps.push_back(emit(p, is_and ? P::JZ : P::JNZ));
+                }
+                emit(p, P::PUSH, 0, is_and ? 1.0f : 0.0f);
+                unsigned end = emit(p, P::JMP);
+                for (unsigned j : jumps)
+                    p.m_code[j].m_arg = p.m_code.size();
+                emit(p, P::PUSH, 0, is_and ? 0.0f : 1.0f);
+                p.m_code[end].m_arg = p.m_code.size();
+                return;
+            }
+            case OP_ITE: {
+                compile(arg(0), p, depth);
+                unsigned jz = emit(p, P::JZ);
+                compile(arg(1), p, depth);
+                unsigned end = emit(p, P::JMP);
+                p.m_code[jz].m_arg = p.m_code.size();
+                compile(arg(2), p, depth);
+                p.m_code[end].m_arg = p.m_code.size();
+                return;
+            }
+            case OP_EQ:       binary(P::EQ); return;
+            case OP_XOR:      binary(P::NEQ); return;
+            case OP_IMPLIES: {
+                compile(arg(0), p, depth);
+                unsigned jz = emit(p, P::JZ);
+                compile(arg(1), p, depth);
+                emit(p, P::BOOL);
+                unsigned end = emit(p, P::JMP);
+                p.m_code[jz].m_arg = p.m_code.size();
+                emit(p, P::PUSH, 0, 1.0f);
+                p.m_code[end].m_arg = p.m_code.size();
+                return;
+            }
+            default:
+                ;
+            }
+        }
+        else if (fid == m_util.get_family_id()) {
+            switch (to_app(f)->get_decl_kind()) {
+            case OP_NUM: {
+                rational r = to_app(f)->get_decl()->get_parameter(0).get_rational();
+                emit(p, P::PUSH, 0, static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64()));
+                return;
+            }
+            case OP_LE:       binary(P::LE); return;
+            case OP_GE:       binary(P::GE); return;
+            case OP_LT:       binary(P::LT); return;
+            case OP_GT:       binary(P::GT); return;
+            case OP_ADD:      binary(P::ADD); return;
+            case OP_SUB:      binary(P::SUB); return;
+            case OP_UMINUS:   compile(arg(0), p, depth); emit(p, P::NEG); return;
+            case OP_MUL:      binary(P::MUL); return;
+            case OP_DIV: {
+                // the divisor is evaluated first, the dividend is skipped if the divisor is 0.
+                compile(arg(1), p, depth);
+                unsigned check = emit(p, P::DIV_CHECK);
+                compile(arg(0), p, depth + 1);
+                emit(p, P::DIV);
+                p.m_code[check].m_arg = p.m_code.size();
+                return;
+            }
+            default:
+                ;
+            }
+        }
+    }
+    else if (is_var(f)) {
+        emit(p, P::VAR, to_var(f)->get_idx());
+        return;
+    }
+    emit(p, P::ERROR);
+}
 
+void cost_evaluator::compile(expr * f, program & p) {
+    p.reset();
+    compile(f, p, 0);
+}
 
+float cost_evaluator::operator()(program const & p, unsigned num_args, float const * args) {
+    typedef program P;
+    SASSERT(!p.empty());
+    m_stack.reserve(p.m_max_stack);
+    float * sp = m_stack.data();      // one past the top of the stack
+    P::instr const * code = p.m_code.data();
+    unsigned pc = 0, end = p.m_code.size();
+#define TOP sp[-1]
+#define BIN(E) --sp; TOP = E; break
+    while (pc < end) {
+        P::instr const & i = code[pc++];
+        switch (i.m_op) {
+        case P::PUSH:  *sp++ = i.m_val; break;
+        case P::VAR:
+            if (i.m_arg < num_args)
+                *sp++ = args[num_args - i.m_arg - 1];
+            else {
+                warning_msg("cost function evaluation error");
+                *sp++ = 1.0f;
+            }
+            break;
+        case P::ERROR:
+            warning_msg("cost function evaluation error");
+            *sp++ = 1.0f;
+            break;
+        case P::NOT:   TOP = TOP == 0.0f ? 1.0f : 0.0f; break;
+        case P::BOOL:  TOP = TOP != 0.0f ? 1.0f : 0.0f; break;
+        case P::EQ:    BIN(TOP == *sp ? 1.0f : 0.0f);
+        case P::NEQ:   BIN(TOP != *sp ? 1.0f : 0.0f);
+        case P::LE:    BIN(TOP <= *sp ? 1.0f : 0.0f);
+        case P::GE:    BIN(TOP >= *sp ? 1.0f : 0.0f);
+        case P::LT:    BIN(TOP <  *sp ? 1.0f : 0.0f);
+        case P::GT:    BIN(TOP >  *sp ? 1.0f : 0.0f);
+        case P::ADD:   BIN(TOP + *sp);
+        case P::SUB:   BIN(TOP - *sp);
+        case P::NEG:   TOP = -TOP; break;
+        case P::MUL:   BIN(TOP * *sp);
+        case P::DIV:   BIN(*sp / TOP);     // the divisor was pushed first
+        case P::DIV_CHECK:
+            if (TOP == 0.0f) {
+                warning_msg("cost function division by zero");
+                TOP = 1.0f;
+                pc = i.m_arg;
+            }
+            break;
+        case P::JZ:    --sp; if (*sp == 0.0f) pc = i.m_arg; break;
+        case P::JNZ:   --sp; if (*sp != 0.0f) pc = i.m_arg; break;
+        case P::JMP:   pc = i.m_arg; break;
+        }
+    }
+#undef TOP
+#undef BIN
+    SASSERT(sp == m_stack.data() + 1);
+    return m_stack[0];
+}
@@ -22,11 +22,42 @@ Revision History:
 #include "ast/arith_decl_plugin.h"
 
 class cost_evaluator {
+public:
+    /**
+       \brief Cost function compiled to code for a stack machine.
+       Conditional jumps implement and, or, ite, implies and the
+       division by zero check, so the compiled code evaluates the same
+       subexpressions as eval and issues the same warnings.
+    */
+    class program {
+        friend class cost_evaluator;
+        enum opcode {
+            PUSH, VAR, ERROR,
+            NOT, BOOL, EQ, NEQ, LE, GE, LT, GT,
+            ADD, SUB, NEG, MUL, DIV, DIV_CHECK,
+            JZ, JNZ, JMP
+        };
+        struct instr {
+            opcode   m_op;
+            unsigned m_arg;     // variable index or jump target
+            float    m_val;     // constant for PUSH
+        };
+        svector<instr> m_code;
+        unsigned       m_max_stack = 0;
+    public:
+        void reset() { m_code.reset(); m_max_stack = 0; }
+        bool empty() const { return m_code.empty(); }
+    };
+
+private:
     ast_manager &   m;
     arith_util      m_util;
     unsigned        m_num_args;
     float const *   m_args;
+    svector<float>  m_stack;
     float eval(expr * f) const;
+    unsigned emit(program & p, program::opcode op, unsigned arg = 0, float val = 0.0f);
+    void compile(expr * f, program & p, unsigned depth);
 public:
     cost_evaluator(ast_manager & m);
     /**
@@ -36,6 +67,13 @@ public:
        (VAR (num_args - 1)) is stored in the first position of the array.
     */
     float operator()(expr * f, unsigned num_args, float const * args);
+
+    /**
+       \brief Compile f into p. The result of evaluating p is the result of evaluating f.
+    */
+    void compile(expr * f, program & p);
+
+    float operator()(program const & p, unsigned num_args, float const * args);
 };
 
 
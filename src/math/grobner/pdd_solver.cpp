@@ -73,12 +73,16 @@ namespace dd {
     void solver::adjust_cfg() {
         auto & cfg = m_config;
         IF_VERBOSE(5, verbose_stream() << "start saturate\n"; display_statistics(verbose_stream()));
-        cfg.m_eqs_threshold = static_cast<unsigned>(cfg.m_eqs_growth * ceil(log(1 + m_to_simplify.size()))* m_to_simplify.size());
+        // processed equations are only present when the saturation is resumed
+        unsigned num_eqs = m_to_simplify.size() + m_processed.size();
+        cfg.m_eqs_threshold = static_cast<unsigned>(cfg.m_eqs_growth * ceil(log(1 + num_eqs))* num_eqs);
         cfg.m_expr_size_limit = 0;
         cfg.m_expr_degree_limit = 0;
-        for (equation* e: m_to_simplify) {
-            cfg.m_expr_size_limit = std::max(cfg.m_expr_size_limit, (unsigned)e->poly().tree_size());
-            cfg.m_expr_degree_limit = std::max(cfg.m_expr_degree_limit, e->poly().degree());            
+        for (equation_vector const* set : { &m_to_simplify, &m_processed }) {
+            for (equation* e : *set) {
+                cfg.m_expr_size_limit = std::max(cfg.m_expr_size_limit, (unsigned)e->poly().tree_size());
+                cfg.m_expr_degree_limit = std::max(cfg.m_expr_degree_limit, e->poly().degree());
+            }
         }
         cfg.m_expr_size_limit *= cfg.m_expr_size_growth;
         cfg.m_expr_degree_limit *= cfg.m_expr_degree_growth;;
@@ -361,6 +365,60 @@ namespace dd {
         m_conflict = nullptr;
     }
 
+    /**
+       \brief Remove the equations and the substitutions p = 0 with the justification d
+       for which is_stale(p, d) holds. The remaining equations are kept for resume().
+       Return the number of removed equations.
+    */
+    unsigned solver::retract(std::function<bool(pdd const&, u_dependency*)> const& is_stale) {
+        unsigned num_retracted = 0;
+        for (equation_vector* set : { &m_solved, &m_processed, &m_to_simplify }) {
+            scoped_update sr(*set);
+            for (; sr.i < sr.sz; ++sr.i) {
+                equation* eq = sr.get();
+                if (!is_stale(eq->poly(), eq->dep())) {
+                    sr.nextj();
+                    continue;
+                }
+                if (eq == m_conflict)
+                    m_conflict = nullptr;
+                retire(eq);
+                ++num_retracted;
+            }
+        }
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_subst.size(); ++i) {
+            auto const& [v, q, d] = m_subst[i];
+            // the substitution is not turned into v - q, which may run out of nodes
+            if (is_stale(m.mk_var(v), d) || is_stale(q, d))
+                continue;
+            if (i != j)
+                m_subst[j] = m_subst[i];
+            ++j;
+        }
+        m_subst.shrink(j);
+        return num_retracted;
+    }
+
+    /**
+       \brief Prepare the equations of the previous saturation for adding more equations
+       and saturating again. The solved equations take part in the simplification again
+       and a conflict is dropped, since it has been reported already.
+    */
+    void solver::resume() {
+        if (m_conflict) {
+            del_equation(m_conflict);
+            m_conflict = nullptr;
+        }
+        for (equation* eq : m_solved)
+            push_equation(processed, eq);
+        m_solved.reset();
+        // new variables get levels in the next init_saturate
+        m_level2var.reset();
+        m_var2level.reset();
+        m_stats.reset();
+    }
+
     void solver::add(pdd const& p, u_dependency * dep) {
         if (p.is_zero()) 
             return;
@@ -150,6 +150,9 @@ public:
     void simplify();
     void saturate();
 
+    unsigned retract(std::function<bool(pdd const&, u_dependency*)> const& is_stale);
+    void resume();
+
     equation_vector const& equations();
 
     void collect_statistics(statistics & st) const;
@@ -38,6 +38,7 @@ class implied_bound {
     // s is expected to be the pointer to lp_bound_propagator.
     u_dependency* explain_implied() const { return m_explain_bound(); }
     void set_explain(std::function<u_dependency*()> f) { m_explain_bound = f; }
+    std::function<u_dependency*()> const& explain_function() const { return m_explain_bound; }
     lconstraint_kind kind() const {
         lconstraint_kind k = m_is_lower_bound? GE : LE;
         if (m_strict)
@@ -110,6 +110,17 @@ public:
 
     void solve();
 
+    bool use_fp_simplex() const;
+
+    void run_fp_simplex();
+
+    void back_off_fp_simplex();
+
+    // number of qualifying solves that skip the floating point stage,
+    // and the number to skip after the next failure
+    unsigned m_fp_simplex_skip = 0;
+    unsigned m_fp_simplex_backoff = 1;
+
     void pivot(int entering, int leaving) { m_r_solver.pivot(entering, leaving); }
     
     bool lower_bounds_are_set() const { return true; }
@@ -14,6 +14,7 @@ Revision History:
 #include <string>
 #include "util/vector.h"
 #include "math/lp/lar_core_solver.h"
+#include "math/lp/lp_fp_simplex.h"
 namespace lp {
 lar_core_solver::lar_core_solver(
     lp_settings & settings,
@@ -94,9 +95,20 @@ void lar_core_solver::solve() {
 	}
     ++m_r_solver.m_settings.stats().m_need_to_solve_inf;
     SASSERT( r_basis_is_OK());
+    if (m_r_A.is_fragmented()) {
+        m_r_A.compact();
+        ++m_r_solver.m_settings.stats().m_tableau_compactions;
+    }
              
-    if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
-         m_r_solver.find_feasible_solution();
+    if (m_r_solver.m_look_for_feasible_solution_only) { //todo : should it be set?
+        if (use_fp_simplex()) {
+            if (m_fp_simplex_skip > 0)
+                --m_fp_simplex_skip;
+            else
+                run_fp_simplex();
+        }
+        m_r_solver.find_feasible_solution();
+    }
     else 
         m_r_solver.solve();
     
@@ -121,4 +133,42 @@ void lar_core_solver::solve() {
   TRACE(lar_solver, tout << m_r_solver.get_status() << "\n";);
 }
 
+bool lar_core_solver::use_fp_simplex() const {
+    return settings().fp_simplex() &&
+        settings().simplex_strategy() == simplex_strategy_enum::tableau_rows &&
+        m_r_solver.m_m() >= settings().fp_simplex_min_rows() &&
+        m_r_solver.inf_heap_size() >= settings().fp_simplex_min_infeasible();
+}
+
+// Look for a feasible basis in floating point numbers. The basis is installed
+// in m_r_solver only if the search succeeded, the rational simplex that runs
+// afterwards certifies it or repairs it. Every run copies the tableau to doubles,
+// so after a run that is not certified the next solves skip the stage, twice as
+// many after each further miss.
+void lar_core_solver::run_fp_simplex() {
+    auto & st = m_r_solver.m_settings.stats();
+    ++st.m_fp_simplex_calls;
+    lp_fp_simplex fp(m_r_solver);
+    lp_status status = fp.solve(4 * (m_r_solver.m_m() + m_r_solver.m_n()));
+    st.m_fp_simplex_iterations += fp.num_iterations();
+    TRACE(lar_solver, tout << "fp simplex: " << lp_status_to_string(status) << ", iterations = " << fp.num_iterations() << "\n";);
+    if (status != lp_status::OPTIMAL) {
+        ++st.m_fp_simplex_failures;
+        back_off_fp_simplex();
+        return;
+    }
+    st.m_fp_simplex_exact_pivots += fp.install_basis();
+    if (m_r_solver.current_x_is_feasible()) {
+        ++st.m_fp_simplex_certified;
+        m_fp_simplex_backoff = 1;
+    }
+    else
+        back_off_fp_simplex();
+}
+
+void lar_core_solver::back_off_fp_simplex() {
+    m_fp_simplex_skip = m_fp_simplex_backoff;
+    m_fp_simplex_backoff = std::min(2 * m_fp_simplex_backoff, 64u);
+}
+
 } // namespace lp
@@ -19,9 +19,13 @@
   --*/
 #pragma once
 #include <algorithm>
+#include <exception>
 #include <functional>
 #include <stack>
 #include <string>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -108,9 +112,13 @@ class lar_solver : public column_namer {
     bool sizes_are_correct() const;
     bool implied_bound_is_correctly_explained(implied_bound const& be, const vector<std::pair<mpq, unsigned>>& explanation) const;
 
+    bool row_is_used_for_bound_propagation(unsigned row_index) const {
+        return A_r().m_rows[row_index].size() <= settings().max_row_length_for_bound_propagation && !row_has_a_big_num(row_index);
+    }
+
     template <typename T>
     unsigned calculate_implied_bounds_for_row(unsigned row_index, lp_bound_propagator<T>& bp) {
-        if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation || row_has_a_big_num(row_index))
+        if (!row_is_used_for_bound_propagation(row_index))
             return 0;
 
         return bound_analyzer_on_row<row_strip<mpq>, lp_bound_propagator<T>>::analyze_row(
@@ -293,13 +301,126 @@ public:
                     row_bounds_to_replay().push_back(i);
             }
         }
-        for (unsigned i : touched_rows()) {
-            calculate_implied_bounds_for_row(i, bp);
-            if (settings().get_cancel_flag())
+        if (use_bound_propagation_batch()) {
+            if (!propagate_bounds_for_batch(bp))
                 return;
         }
+        else {
+            for (unsigned i : touched_rows()) {
+                calculate_implied_bounds_for_row(i, bp);
+                if (settings().get_cancel_flag())
+                    return;
+            }
+        }
         touched_rows().reset();
     }
+private:
+    /**
+       \brief Receives the bounds found by bound_analyzer_on_row for one row without
+       filtering them. The filtering by lp_bound_propagator::add_bound needs the
+       search state, so it runs on the search thread after the batch is analyzed.
+    */
+    class implied_bound_collector {
+        lar_solver&                 m_lar;
+        std_vector<implied_bound>&  m_bounds;
+    public:
+        implied_bound_collector(lar_solver& lar, std_vector<implied_bound>& bounds): m_lar(lar), m_bounds(bounds) {}
+        const lar_solver& lp() const { return m_lar; }
+        lar_solver& lp() { return m_lar; }
+        bool upper_bound_is_available(unsigned j) const {
+            switch (m_lar.get_column_type(j)) {
+            case column_type::fixed:
+            case column_type::boxed:
+            case column_type::upper_bound:
+                return true;
+            default:
+                return false;
+            }
+        }
+        bool lower_bound_is_available(unsigned j) const {
+            switch (m_lar.get_column_type(j)) {
+            case column_type::fixed:
+            case column_type::boxed:
+            case column_type::lower_bound:
+                return true;
+            default:
+                return false;
+            }
+        }
+        void add_bound(mpq const& v, unsigned j, bool is_low, bool strict, std::function<u_dependency* ()> explain_bound) {
+            m_bounds.push_back(implied_bound(v, j, is_low, strict, explain_bound));
+        }
+    };
+
+    bool use_bound_propagation_batch() {
+        return settings().bprop_threads() > 1 && touched_rows().size() >= settings().bprop_batch_min_rows();
+    }
+
+    /**
+       \brief Analyze the touched rows on settings().bprop_threads() threads.
+       The tableau and the bounds are only read during the analysis. The bounds
+       found for the rows are passed to bp in the order of touched_rows(), so bp
+       receives the same bounds as from the sequential analysis.
+       Return false if the search was canceled during the analysis.
+    */
+    template <typename T>
+    bool propagate_bounds_for_batch(lp_bound_propagator<T>& bp) {
+        unsigned_vector rows;
+        for (unsigned i : touched_rows())
+            if (row_is_used_for_bound_propagation(i))
+                rows.push_back(i);
+        unsigned num_rows = rows.size();
+        std_vector<std_vector<implied_bound>> bounds(num_rows);
+        unsigned num_threads = std::max(1u, std::min(settings().bprop_threads(), num_rows));
+#ifdef SINGLE_THREAD
+        num_threads = 1;
+#endif
+        vector<std::exception_ptr> ex(num_threads);
+        auto analyze = [&](unsigned t) {
+            try {
+                // rows are dealt out in turn, so long and short rows are spread over the threads;
+                // the cancel flag is not polled here since polling updates the resource limit
+                for (unsigned k = t; k < num_rows; k += num_threads) {
+                    implied_bound_collector c(*this, bounds[k]);
+                    bound_analyzer_on_row<row_strip<mpq>, implied_bound_collector>::analyze_row(
+                        A_r().m_rows[rows[k]],
+                        zero_of_type<numeric_pair<mpq>>(),
+                        c);
+                }
+            }
+            catch (...) {
+                ex[t] = std::current_exception();
+            }
+        };
+        if (num_threads == 1)
+            analyze(0);
+#ifndef SINGLE_THREAD
+        else {
+            vector<std::thread> threads(num_threads);
+            for (unsigned t = 0; t < num_threads; ++t)
+                threads[t] = std::thread([&, t]() { analyze(t); });
+            for (auto& th : threads)
+                th.join();
+        }
+#endif
+        for (auto& e : ex)
+            if (e)
+                std::rethrow_exception(e);
+        if (settings().get_cancel_flag())
+            return false;
+        unsigned num_bounds = 0;
+        for (auto const& row_bounds : bounds) {
+            for (auto const& ib : row_bounds)
+                bp.add_bound(ib.m_bound, ib.m_j, ib.m_is_lower_bound, ib.m_strict, ib.explain_function());
+            num_bounds += static_cast<unsigned>(row_bounds.size());
+        }
+        stats().m_bprop_batches++;
+        stats().m_bprop_batch_rows += num_rows;
+        stats().m_bprop_batch_bounds += num_bounds;
+        stats().m_bprop_max_batch_bounds = std::max(stats().m_bprop_max_batch_bounds, num_bounds);
+        return true;
+    }
+public:
     void collect_more_rows_for_lp_propagation();
     template <typename T>
     void check_missed_propagations(lp_bound_propagator<T>& bp) {
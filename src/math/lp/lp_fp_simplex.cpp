@@ -0,0 +1,250 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    lp_fp_simplex.cpp
+
+Abstract:
+
+    Floating point stage of the feasibility search in lar_core_solver.
+
+--*/
+#include "math/lp/static_matrix_def.h"
+#include "math/lp/lp_fp_simplex.h"
+
+namespace lp {
+
+    bool lp_fp_simplex::has_lower(unsigned j) const {
+        return m_r.column_has_lower_bound(j);
+    }
+
+    bool lp_fp_simplex::has_upper(unsigned j) const {
+        return m_r.column_has_upper_bound(j);
+    }
+
+    bool lp_fp_simplex::below_lower(unsigned j) const {
+        return has_lower(j) && m_x[j] < m_lower[j] - s_feas_tol * (1 + std::abs(m_lower[j]));
+    }
+
+    bool lp_fp_simplex::above_upper(unsigned j) const {
+        return has_upper(j) && m_x[j] > m_upper[j] + s_feas_tol * (1 + std::abs(m_upper[j]));
+    }
+
+    bool lp_fp_simplex::can_increase(unsigned j) const {
+        return !has_upper(j) || m_x[j] < m_upper[j];
+    }
+
+    bool lp_fp_simplex::can_decrease(unsigned j) const {
+        return !has_lower(j) || m_x[j] > m_lower[j];
+    }
+
+    void lp_fp_simplex::track_feasibility(unsigned j) {
+        if (is_feasible(j)) {
+            if (m_inf_heap.contains(j))
+                m_inf_heap.erase(j);
+        }
+        else if (!m_inf_heap.contains(j))
+            m_inf_heap.insert(j);
+    }
+
+    bool lp_fp_simplex::init() {
+        unsigned m = m_r.m_m(), n = m_r.m_n();
+        m_A.init_empty_matrix(m, n);
+        for (unsigned i = 0; i < m; ++i) {
+            for (auto const& rc : m_r.m_A.m_rows[i]) {
+                double v = rc.coeff().get_double();
+                if (std::abs(v) > s_max_value)
+                    return false;
+                m_A.add_new_element(i, rc.var(), v);
+            }
+        }
+        m_basis = m_r.m_basis;
+        m_heading.assign(n, -1);
+        for (unsigned i = 0; i < m; ++i)
+            m_heading[m_basis[i]] = i;
+        m_x.resize(n);
+        m_lower.resize(n);
+        m_upper.resize(n);
+        m_at_bound.resize(n, 0);
+        for (unsigned j = 0; j < n; ++j) {
+            m_x[j] = to_double(m_r.m_x[j]);
+            m_lower[j] = has_lower(j) ? to_double(m_r.m_lower_bounds[j]) : 0;
+            m_upper[j] = has_upper(j) ? to_double(m_r.m_upper_bounds[j]) : 0;
+            if (std::abs(m_x[j]) > s_max_value)
+                return false;
+        }
+        m_inf_heap.reserve(n);
+        for (unsigned j : m_basis)
+            track_feasibility(j);
+        return true;
+    }
+
+    /**
+       \brief Find the column entering the basis instead of the basic column of row i.
+       The basic column has to grow if grow is true and to shrink otherwise.
+       Outside of the Bland mode the column with the largest coefficient is taken,
+       ties are broken by the shorter column. Tiny coefficients relative to the
+       largest one of the row are not used as pivots.
+    */
+    int lp_fp_simplex::find_entering(unsigned i, bool grow, bool bland, double& a_ent) const {
+        unsigned b = m_basis[i];
+        double max_abs = 0;
+        for (auto const& rc : m_A.m_rows[i])
+            if (rc.var() != b)
+                max_abs = std::max(max_abs, std::abs(rc.coeff()));
+        double min_abs = std::max(s_pivot_tol, 1e-7 * max_abs);
+        int best = -1;
+        double best_abs = 0;
+        unsigned best_sz = UINT_MAX;
+        for (auto const& rc : m_A.m_rows[i]) {
+            unsigned j = rc.var();
+            double a = rc.coeff();
+            double a_abs = std::abs(a);
+            if (j == b || a_abs < min_abs)
+                continue;
+            // x_b = - sum a_j x_j, so x_b grows when a_j * x_j decreases
+            if ((grow == (a > 0)) ? !can_decrease(j) : !can_increase(j))
+                continue;
+            unsigned sz = m_A.m_columns[j].size();
+            bool better = best == -1 ||
+                (bland ? j < static_cast<unsigned>(best) :
+                 a_abs > best_abs || (a_abs == best_abs && sz < best_sz));
+            if (!better)
+                continue;
+            best = j;
+            best_abs = a_abs;
+            best_sz = sz;
+            a_ent = a;
+        }
+        return best;
+    }
+
+    bool lp_fp_simplex::pivot(unsigned entering, unsigned row) {
+        auto& column = m_A.m_columns[entering];
+        int k = -1;
+        for (unsigned l = 0; l < column.size(); ++l) {
+            if (column[l].var() == row) {
+                k = l;
+                break;
+            }
+        }
+        if (k < 0)
+            return false;
+        double a = m_A.get_val(column[k]);
+        m_A.divide_row(row, a);
+        if (k != 0) {
+            auto c = column[0];
+            column[0] = column[k];
+            column[k] = c;
+            m_A.m_rows[row][column[0].offset()].offset() = 0;
+            m_A.m_rows[c.var()][c.offset()].offset() = k;
+        }
+        while (column.size() > 1) {
+            auto& c = column.back();
+            unsigned ii = c.var();
+            m_A.pivot_row_to_row_given_cell(row, c, entering);
+            auto& r = m_A.m_rows[ii];
+            for (unsigned l = r.size(); l-- > 0; ) {
+                double v = std::abs(r[l].coeff());
+                if (v > s_max_value)
+                    return false;
+                if (v < s_drop_tol)
+                    m_A.remove_element(r, r[l]);
+            }
+        }
+        return true;
+    }
+
+    lp_status lp_fp_simplex::solve(unsigned max_iterations) {
+        if (!init())
+            return lp_status::UNKNOWN;
+        // the second half of the iterations uses the smallest eligible column to break
+        // cycles between a few rows, only the iteration limit bounds the search
+        unsigned bland_iterations = max_iterations / 2;
+        while (!m_inf_heap.empty()) {
+            if (m_r.m_settings.get_cancel_flag() || m_num_iterations >= max_iterations)
+                return lp_status::UNKNOWN;
+            unsigned b = m_inf_heap.min_value();
+            unsigned i = m_heading[b];
+            bool grow = below_lower(b);
+            double a_ent = 0;
+            int j = find_entering(i, grow, m_num_iterations >= bland_iterations, a_ent);
+            if (j < 0)
+                return lp_status::INFEASIBLE;
+            double new_val = grow ? m_lower[b] : m_upper[b];
+            double theta = (m_x[b] - new_val) / a_ent;
+            m_x[j] += theta;
+            m_touched.reset();
+            for (auto const& c : m_A.m_columns[j]) {
+                unsigned bk = m_basis[c.var()];
+                if (bk == b)
+                    continue;
+                m_x[bk] -= theta * m_A.get_val(c);
+                m_touched.push_back(bk);
+            }
+            m_x[b] = new_val;
+            m_at_bound[b] = grow ? -1 : 1;
+            m_at_bound[j] = 0;
+            m_inf_heap.erase(b);
+            if (std::abs(m_x[j]) > s_max_value || !pivot(j, i))
+                return lp_status::UNKNOWN;
+            m_basis[i] = j;
+            m_heading[j] = i;
+            m_heading[b] = -1;
+            track_feasibility(j);
+            for (unsigned bk : m_touched)
+                track_feasibility(bk);
+            ++m_num_iterations;
+        }
+        return lp_status::OPTIMAL;
+    }
+
+    void lp_fp_simplex::set_exact_value(unsigned j, numeric_pair<mpq> const& v) {
+        if (v != m_r.m_x[j])
+            m_r.add_delta_to_entering(j, v - m_r.m_x[j]);
+    }
+
+    unsigned lp_fp_simplex::install_basis() {
+        unsigned num_pivots = 0;
+        for (unsigned j : m_basis) {
+            if (m_r.column_is_base(j))
+                continue;
+            // the pivot row is the shortest row whose basic column is not basic in m_basis
+            int row = -1;
+            unsigned row_sz = UINT_MAX;
+            for (auto const& c : m_r.m_A.m_columns[j]) {
+                unsigned i = c.var();
+                unsigned sz = m_r.m_A.m_rows[i].size();
+                if (m_heading[m_r.m_basis[i]] >= 0 || sz >= row_sz)
+                    continue;
+                row = i;
+                row_sz = sz;
+            }
+            if (row < 0)
+                continue;
+            unsigned leaving = m_r.m_basis[row];
+            if (!m_r.pivot_column_tableau(j, row))
+                continue;
+            m_r.change_basis(j, leaving);
+            ++num_pivots;
+        }
+        for (unsigned j = 0; j < m_r.m_n(); ++j) {
+            if (m_r.column_is_base(j))
+                continue;
+            if (m_heading[j] < 0 && m_at_bound[j] < 0 && has_lower(j))
+                set_exact_value(j, m_r.m_lower_bounds[j]);
+            else if (m_heading[j] < 0 && m_at_bound[j] > 0 && has_upper(j))
+                set_exact_value(j, m_r.m_upper_bounds[j]);
+            else if (has_lower(j) && m_r.x_below_low_bound(j))
+                set_exact_value(j, m_r.m_lower_bounds[j]);
+            else if (has_upper(j) && m_r.x_above_upper_bound(j))
+                set_exact_value(j, m_r.m_upper_bounds[j]);
+        }
+        m_r.clear_inf_heap();
+        for (unsigned j : m_r.m_basis)
+            if (!m_r.column_is_feasible(j))
+                m_r.insert_column_into_inf_heap(j);
+        return num_pivots;
+    }
+}
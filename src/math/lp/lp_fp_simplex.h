@@ -0,0 +1,96 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    lp_fp_simplex.h
+
+Abstract:
+
+    Floating point stage of the feasibility search in lar_core_solver.
+
+    The rational tableau, the values and the bounds are copied to
+    doubles, and a row-fixing heuristic is run on the copy: an
+    infeasible basic column is put at its violated bound by pivoting it
+    with a non-basic column of its row that can move in the needed
+    direction. There is no ratio test, so a pivot can push other basic
+    columns out of their bounds; they are fixed in later iterations.
+    If a basis is found where all columns are within their bounds, it is
+    installed in the rational tableau by exact pivots, the non-basic
+    columns that left the basis are put at the exact bound they
+    reached, and the basic values are recomputed exactly. The rational
+    simplex runs afterwards as usual: it certifies the basis when the
+    exact values are feasible and repairs it otherwise. A failure of
+    the floating point stage (iteration limit, numerical trouble, a
+    row without entering column) leaves the rational solver untouched.
+
+    Reference: Applegate, Cook, Dash, Espinoza. Exact solutions to
+    linear programming problems. Oper. Res. Lett. 35(6), 2007.
+
+--*/
+#pragma once
+
+#include "math/lp/lp_core_solver_base.h"
+#include "math/lp/static_matrix.h"
+
+namespace lp {
+
+    class lp_fp_simplex {
+        typedef lp_core_solver_base<mpq, numeric_pair<mpq>> exact_solver;
+        exact_solver&                 m_r;
+        static_matrix<double, double> m_A;
+        vector<double>                m_x;
+        vector<double>                m_lower;
+        vector<double>                m_upper;
+        vector<unsigned>              m_basis;
+        std_vector<int>               m_heading;   // row of a basic column, -1 for non-basic columns
+        svector<signed char>          m_at_bound;  // -1 (1) if the column left the basis at its lower (upper) bound
+        lpvar_heap                    m_inf_heap;  // infeasible basic columns
+        unsigned_vector               m_touched;
+        unsigned                      m_num_iterations = 0;
+
+        static constexpr double s_feas_tol = 1e-9;
+        static constexpr double s_pivot_tol = 1e-9;
+        static constexpr double s_drop_tol = 1e-13;
+        static constexpr double s_max_value = 1e12;   // larger coefficients or values are treated as numerical trouble
+        static constexpr double s_delta = 1e-6;       // stands for the infinitesimal of strict bounds
+
+        static double to_double(numeric_pair<mpq> const& v) {
+            return v.x.get_double() + s_delta * v.y.get_double();
+        }
+
+        bool has_lower(unsigned j) const;
+        bool has_upper(unsigned j) const;
+        bool below_lower(unsigned j) const;
+        bool above_upper(unsigned j) const;
+        bool is_feasible(unsigned j) const { return !below_lower(j) && !above_upper(j); }
+        bool can_increase(unsigned j) const;
+        bool can_decrease(unsigned j) const;
+        void track_feasibility(unsigned j);
+
+        bool init();
+        int  find_entering(unsigned i, bool grow, bool bland, double& a_ent) const;
+        bool pivot(unsigned entering, unsigned row);
+        void set_exact_value(unsigned j, numeric_pair<mpq> const& v);
+
+    public:
+        lp_fp_simplex(exact_solver& r): m_r(r), m_inf_heap(r.m_n()) {}
+
+        /**
+           \brief Run the floating point simplex for at most max_iterations pivots.
+           Return OPTIMAL if a feasible basis was found, INFEASIBLE if a row without
+           entering column was found, and UNKNOWN if the search failed.
+           Only an OPTIMAL result is installed: without a ratio test the basis
+           reached on INFEASIBLE is not a useful starting point for the exact solver.
+        */
+        lp_status solve(unsigned max_iterations);
+
+        /**
+           \brief Install the basis found by solve in the exact solver.
+           Return the number of exact pivots.
+        */
+        unsigned install_basis();
+
+        unsigned num_iterations() const { return m_num_iterations; }
+    };
+}
@@ -48,6 +48,11 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     m_random_hammers = lp_p.random_hammers();
     m_lcube = lp_p.lcube();
     m_lcube_flips = lp_p.lcube_flips();
+    m_fp_simplex = lp_p.fp_simplex();
+    m_fp_simplex_min_rows = lp_p.fp_simplex_min_rows();
+    m_fp_simplex_min_infeasible = lp_p.fp_simplex_min_infeasible();
+    m_bprop_threads = lp_p.bprop_threads();
+    m_bprop_batch_min_rows = lp_p.bprop_batch_min_rows();
     unsigned hammer_period = lp_p.int_hammer_period();
     SASSERT(hammer_period != 0);
     m_int_find_cube_period = hammer_period;
@@ -140,6 +140,18 @@ struct statistics {
     unsigned m_bounds_tightening_conflicts = 0;
     unsigned m_bounds_tightenings = 0;
     unsigned m_nla_throttled_lemmas = 0;
+    unsigned m_fp_simplex_calls = 0;
+    unsigned m_fp_simplex_iterations = 0;
+    unsigned m_fp_simplex_exact_pivots = 0;
+    unsigned m_fp_simplex_certified = 0;
+    unsigned m_fp_simplex_failures = 0;
+    unsigned m_tableau_compactions = 0;
+    unsigned m_grobner_resumed = 0;
+    unsigned m_grobner_retracted = 0;
+    unsigned m_bprop_batches = 0;
+    unsigned m_bprop_batch_rows = 0;
+    unsigned m_bprop_batch_bounds = 0;
+    unsigned m_bprop_max_batch_bounds = 0;
 
     ::statistics m_st = {};
 
@@ -182,6 +194,18 @@ struct statistics {
         st.update("arith-bounds-tightening-conflicts", m_bounds_tightening_conflicts);
         st.update("arith-bounds-tightenings", m_bounds_tightenings);
         st.update("arith-nla-throttled-lemmas", m_nla_throttled_lemmas);
+        st.update("arith-fp-simplex-calls", m_fp_simplex_calls);
+        st.update("arith-fp-simplex-iterations", m_fp_simplex_iterations);
+        st.update("arith-fp-simplex-exact-pivots", m_fp_simplex_exact_pivots);
+        st.update("arith-fp-simplex-certified", m_fp_simplex_certified);
+        st.update("arith-fp-simplex-failures", m_fp_simplex_failures);
+        st.update("arith-tableau-compactions", m_tableau_compactions);
+        st.update("arith-grobner-resumed", m_grobner_resumed);
+        st.update("arith-grobner-retracted", m_grobner_retracted);
+        st.update("arith-bprop-batches", m_bprop_batches);
+        st.update("arith-bprop-batch-rows", m_bprop_batch_rows);
+        st.update("arith-bprop-batch-bounds", m_bprop_batch_bounds);
+        st.update("arith-bprop-max-batch-bounds", m_bprop_max_batch_bounds);
         st.copy(m_st);
     }
 };
@@ -270,9 +294,19 @@ private:
     bool             m_random_hammers = true;
     bool             m_lcube = true;
     unsigned         m_lcube_flips = 16;
+    bool             m_fp_simplex = false;
+    unsigned         m_fp_simplex_min_rows = 1000;
+    unsigned         m_fp_simplex_min_infeasible = 16;
+    unsigned         m_bprop_threads = 1;
+    unsigned         m_bprop_batch_min_rows = 1000;
 public:
     bool lcube() const { return m_lcube; }
     unsigned lcube_flips() const { return m_lcube_flips; }
+    bool fp_simplex() const { return m_fp_simplex; }
+    unsigned fp_simplex_min_rows() const { return m_fp_simplex_min_rows; }
+    unsigned fp_simplex_min_infeasible() const { return m_fp_simplex_min_infeasible; }
+    unsigned bprop_threads() const { return m_bprop_threads; }
+    unsigned bprop_batch_min_rows() const { return m_bprop_batch_min_rows; }
     unsigned dio_calls_period() const { return m_dio_calls_period; }
     unsigned & dio_calls_period() { return m_dio_calls_period; }
     unsigned dio_calls_period_decrease() const { return m_dio_calls_period_decrease; }
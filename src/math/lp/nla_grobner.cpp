@@ -35,6 +35,74 @@ namespace nla {
         m_config.m_propagate_quotients = ph.arith_nl_grobner_propagate_quotients();
         m_config.m_gcd_test = ph.arith_nl_grobner_gcd_test();
         m_config.m_expand_terms = ph.arith_nl_grobner_expand_terms();
+        m_config.m_incremental = ph.arith_nl_grobner_incremental();
+    }
+
+    void grobner::push() {
+        ++m_scope_lvl;
+    }
+
+    /**
+       \brief Retract the kept equations that become stale by popping n scopes.
+       It is called after lar_solver::pop, so the columns of the popped scopes are removed already.
+    */
+    void grobner::pop(unsigned n) {
+        SASSERT(n <= m_scope_lvl);
+        m_scope_lvl -= n;
+        if (!m_has_basis)
+            return;
+        // the dependencies created in the popped scopes are deallocated
+        bool drop_deps = m_scope_lvl < m_basis_lvl;
+        unsigned num_columns = lra.column_count();
+        if (!drop_deps && num_columns >= m_basis_columns)
+            return;
+        retract_stale(num_columns, drop_deps);
+        m_basis_lvl = std::min(m_basis_lvl, m_scope_lvl);
+        m_basis_columns = num_columns;
+    }
+
+    /**
+       \brief Remove the equations that use popped columns, and the equations with dependencies if drop_deps holds.
+       The equations without dependencies are consequences of the rows and stay valid.
+    */
+    void grobner::retract_stale(unsigned num_columns, bool drop_deps) {
+        auto is_stale = [&](dd::pdd const& p, u_dependency* dep) {
+            if (dep && drop_deps)
+                return true;
+            for (unsigned v : m_pdd_manager.free_vars(p))
+                if (v >= num_columns)
+                    return true;
+            return false;
+        };
+        lp_settings().stats().m_grobner_retracted += m_solver.retract(is_stale);
+        // the rows are added again in the next call, those that are still implied reduce to zero
+        m_inputs.reset();
+        m_input_ids.reset();
+    }
+
+    /**
+       \brief Continue from the equations of the previous calls in incremental mode,
+       otherwise start from an empty set of equations.
+    */
+    bool grobner::resume_basis() {
+        // the kept equations hold on to their nodes, so start over when they use many of them.
+        // incremental mode may have been turned off since the basis was kept.
+        if (!m_config.m_incremental || !m_has_basis || m_pdd_manager.num_nodes() > m_config.m_max_pdd_nodes / 2) {
+            reset_basis();
+            return false;
+        }
+        lp_settings().stats().m_grobner_resumed++;
+        m_solver.resume();
+        return true;
+    }
+
+    void grobner::reset_basis() {
+        m_solver.reset();
+        m_inputs.reset();
+        m_input_ids.reset();
+        m_has_basis = false;
+        m_basis_lvl = 0;
+        m_basis_columns = 0;
     }
 
     lp::lp_settings& grobner::lp_settings() {
@@ -618,9 +686,10 @@ namespace nla {
     }
 
     bool grobner::configure() {
-        m_solver.reset();
+        bool resumed = resume_basis();
         try {
-            set_level2var();
+            if (!resumed)
+                set_level2var();
             TRACE(grobner,
                   tout << "base vars: ";
                   for (lpvar j : c().active_var_set())
@@ -637,8 +706,14 @@ namespace nla {
         }
         catch (dd::pdd_manager::mem_out) {
             IF_VERBOSE(2, verbose_stream() << "pdd throw\n");
+            reset_basis();
             return false;
         }
+        if (m_config.m_incremental) {
+            m_has_basis = true;
+            m_basis_lvl = std::max(m_basis_lvl, m_scope_lvl);
+            m_basis_columns = std::max(m_basis_columns, lra.column_count());
+        }
         TRACE(grobner, m_solver.display(tout));
 
         struct dd::solver::config cfg;
@@ -665,7 +740,7 @@ namespace nla {
         cfg.m_number_of_conflicts_to_report = c().params().arith_nl_grobner_cnfl_to_report();
         m_solver.set(cfg);
         m_solver.adjust_cfg();
-        m_pdd_manager.set_max_num_nodes(10000); // or something proportional to the number of initial nodes.
+        m_pdd_manager.set_max_num_nodes(m_config.m_max_pdd_nodes); // or something proportional to the number of initial nodes.
 
         return true;
     }
@@ -943,6 +1018,13 @@ namespace nla {
        \brief add an equality to grobner solver, convert it to solved form if available.
     */    
     void grobner::add_eq(dd::pdd& p, u_dependency* dep) {
+        if (m_config.m_incremental) {
+            // the equation of an unchanged row is in the kept equations already
+            if (m_input_ids.contains(p.index()))
+                return;
+            m_input_ids.insert(p.index());
+            m_inputs.push_back(p);
+        }
         unsigned v;
         dd::pdd q(m_pdd_manager);
         m_solver.simplify(p, dep);
@@ -961,7 +1043,7 @@ namespace nla {
         add_eq(r, dep);
     }
 
-    void grobner::add_row(const std_vector<lp::row_cell<rational>> & row) {
+    void grobner::add_row(const lp::row_strip<rational> & row) {
         u_dependency *dep = nullptr;
         rational val;
         dd::pdd sum = m_pdd_manager.mk_val(rational(0));
@@ -24,6 +24,8 @@ namespace nla {
             bool m_propagate_quotients = false;
             bool m_gcd_test = false;
             bool m_expand_terms = false;
+            bool m_incremental = false;
+            unsigned m_max_pdd_nodes = 10000;
             // Adaptive growth (gated by arith.nl.grobner_adaptive). m_growth_boost
             // is in fixed-point units of 1/m_adaptive_unit (m_adaptive_unit == 1.0x).
             unsigned m_adaptive_unit       = 16;
@@ -43,6 +45,14 @@ namespace nla {
         bool                     m_add_all_eqs = false;
         std::unordered_map<unsigned_vector, lpvar, hash_svector> m_mon2var;
 
+        // incremental mode: the equations are kept between the calls until they become stale
+        vector<dd::pdd>          m_inputs;           // polynomials of the rows and the fixed monics added so far
+        uint_set                 m_input_ids;        // roots of m_inputs
+        bool                     m_has_basis = false;
+        unsigned                 m_scope_lvl = 0;
+        unsigned                 m_basis_lvl = 0;    // dependencies in m_solver are created at this level or below
+        unsigned                 m_basis_columns = 0;
+
         lp::lp_settings& lp_settings();
 
         // solving
@@ -82,11 +92,14 @@ namespace nla {
 
         // setup
         bool configure();
+        bool resume_basis();
+        void reset_basis();
+        void retract_stale(unsigned num_columns, bool drop_deps);
         void set_level2var();
         void find_nl_cluster();
         void prepare_rows_and_active_vars();
         void add_var_and_its_factors_to_q_and_collect_new_rows(lpvar j, svector<lpvar>& q);           
-        void add_row(const std_vector<lp::row_cell<rational>>& row);
+        void add_row(const lp::row_strip<rational>& row);
         void add_fixed_monic(unsigned j);
         bool is_solved(dd::pdd const& p, unsigned& v, dd::pdd& r);
         void add_eq(dd::pdd& p, u_dependency* dep);        
@@ -102,5 +115,7 @@ namespace nla {
         grobner(core *core);        
         void operator()();
         void updt_params(params_ref const& p);
+        void push();
+        void pop(unsigned n);
     }; 
 }
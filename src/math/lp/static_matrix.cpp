@@ -59,5 +59,11 @@ namespace lp {
     template void static_matrix<mpq,mpq>::add_rows(mpq const &,unsigned int,unsigned int);
     template void static_matrix<mpq, mpq>:: pivot_term_to_row_given_cell<lar_term>(lar_term const & term, column_cell&c, unsigned j, int j_sign);
     template void static_matrix<mpq, mpq>::add_term_to_row<lar_term>(const mpq& alpha, lar_term const & term, unsigned ii);
-    template void static_matrix<mpq, numeric_pair<mpq> >::remove_element(std::vector<row_cell<mpq>, std_allocator<row_cell<mpq> > >&, row_cell<mpq>&);
+    template void static_matrix<mpq, numeric_pair<mpq> >::compact();
+    template void static_matrix<mpq, numeric_pair<mpq> >::remove_element(row_strip<mpq>&, row_cell<mpq>&);
+
+    // the floating point tableau of lp_fp_simplex
+    double numeric_traits<double>::g_zero = 0.0;
+    double numeric_traits<double>::g_one = 1.0;
+    template double static_matrix<double, double>::get_elem(unsigned int, unsigned int) const;
 }
@@ -12,6 +12,7 @@ Author:
 #include <utility>
 #include "math/lp/indexed_vector.h"
 #include "math/lp/permutation_matrix.h"
+#include "math/lp/strip_arena.h"
 #include <stack>
 namespace lp {
 
@@ -39,10 +40,10 @@ std::ostream& operator<<(std::ostream& out, const row_cell<T>& rc) {
 }
 struct empty_struct {};
 typedef row_cell<empty_struct> column_cell;
-typedef std_vector<column_cell> column_strip;
+typedef std::vector<column_cell, strip_allocator<column_cell>> column_strip;
 
 template <typename T>
-using row_strip = std_vector<row_cell<T>>; 
+using row_strip = std::vector<row_cell<T>, strip_allocator<row_cell<T>>>;
 template <typename K> mpq get_denominators_lcm(const K & row) {
     SASSERT(row.size() > 0);
     mpq r = mpq(1);
@@ -81,6 +82,7 @@ class static_matrix
         dim(unsigned m, unsigned n) :m_m(m), m_n(n) {}
     };
     std::stack<dim> m_stack;
+    strip_arena     m_arena;   // the cells of m_rows and m_columns
 public:
     
     vector<int> m_work_vector_of_row_offsets;
@@ -120,6 +122,9 @@ public:
     static_matrix(unsigned m, unsigned n): m_work_vector_of_row_offsets(n, -1)  {
         init_row_columns(m, n);
     }
+    // the strips refer to m_arena, so a matrix is neither copied nor moved
+    static_matrix(static_matrix const&) = delete;
+    static_matrix& operator=(static_matrix const&) = delete;
     
     void clear();
 
@@ -141,15 +146,20 @@ public:
 
     // adds row i muliplied by coeff to row k
     void add_rows(const mpq& coeff, unsigned i, unsigned k);
-    void add_row() {m_rows.push_back(row_strip<T>());}
+    void add_row() { m_rows.push_back(row_strip<T>(strip_allocator<row_cell<T>>(&m_arena))); }
     void add_column() {
-        m_columns.push_back(column_strip());
+        m_columns.push_back(column_strip(strip_allocator<column_cell>(&m_arena)));
         m_work_vector_of_row_offsets.push_back(-1);
     }
 
     void add_columns_up_to(unsigned j) { while (j >= column_count()) add_column(); }
 
-    void remove_element(std_vector<row_cell<T>> & row, row_cell<T> & elem_to_remove);
+    bool is_fragmented() const { return m_arena.is_fragmented(); }
+
+    // lay out the rows and then the columns consecutively, invalidates references to the cells
+    void compact();
+
+    void remove_element(row_strip<T> & row, row_cell<T> & elem_to_remove);
 
     void remove_element(unsigned ei, row_cell<T> & elem_to_remove) {
         remove_element(m_rows[ei], elem_to_remove);
@@ -244,7 +254,7 @@ public:
         m_stack.push(d);
     }
 
-    void pop_row_columns(const std_vector<row_cell<T>> & row) {
+    void pop_row_columns(const row_strip<T> & row) {
         for (auto & c : row) {
             unsigned j = c.var();
             auto & col = m_columns[j];
@@ -34,10 +34,10 @@ namespace lp {
     void  static_matrix<T, X>::init_row_columns(unsigned m, unsigned n) {
         SASSERT(m_rows.size() == 0 && m_columns.size() == 0);
         for (unsigned i = 0; i < m; ++i) {
-            m_rows.push_back(row_strip<T>());
+            add_row();
         }
         for (unsigned j = 0; j < n; ++j) {
-            m_columns.push_back(column_strip());
+            m_columns.push_back(column_strip(strip_allocator<column_cell>(&m_arena)));
         }
     }
 
@@ -224,6 +224,22 @@ namespace lp {
     }
 
 
+    template <typename T, typename X> void static_matrix<T, X>::compact() {
+        auto move_strip = [&](auto& strip) {
+            typename std::remove_reference<decltype(strip)>::type r(strip.get_allocator());
+            r.reserve(strip.size() + strip.size() / 4);
+            for (auto& c : strip)
+                r.push_back(std::move(c));
+            strip = std::move(r);
+        };
+        m_arena.start_compaction();
+        for (auto& row : m_rows)
+            move_strip(row);
+        for (auto& column : m_columns)
+            move_strip(column);
+        m_arena.end_compaction();
+    }
+
     template <typename T, typename X> void static_matrix<T, X>::clear() {
         m_work_vector_of_row_offsets.clear();
         m_rows.clear();
@@ -456,7 +472,7 @@ namespace lp {
     }
 
     template <typename T, typename X>
-    void static_matrix<T, X>::remove_element(std_vector<row_cell<T>> & row_vals, row_cell<T> & row_el_iv) {
+    void static_matrix<T, X>::remove_element(row_strip<T> & row_vals, row_cell<T> & row_el_iv) {
         unsigned column_offset = row_el_iv.offset();
         auto & column_vals = m_columns[row_el_iv.var()];
         column_cell& cs = m_columns[row_el_iv.var()][column_offset];
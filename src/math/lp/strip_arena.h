@@ -0,0 +1,173 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    strip_arena.h
+
+Abstract:
+
+    Slab storage for the rows and the columns of static_matrix.
+
+    The strips stay std::vectors, so m_rows and m_columns are iterated
+    and updated as before, but their cells are allocated from large
+    slabs owned by the matrix instead of one heap block per strip.
+    Freed blocks are reused through free lists, one per block size.
+    The first slab is small and the slab size doubles up to a limit, so
+    that small matrices do not reserve much memory.
+
+    Fill-in during pivoting moves strips around and leaves holes in the
+    slabs. static_matrix::compact rewrites all rows and then all columns
+    consecutively into fresh slabs, with some slack capacity, so that a
+    pass over the tableau reads the memory in order, as with compressed
+    row and column storage. The slabs of the old layout are released in
+    one step at the end of the compaction.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "util/memory_manager.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace lp {
+
+    class strip_arena {
+        static const unsigned c_min_slab = 1 << 12;
+        static const unsigned c_max_slab = 1 << 16;
+        static const unsigned c_max_block = 4096;   // larger blocks are allocated on the heap
+        static const unsigned c_align = 8;
+
+        ptr_vector<char> m_slabs;
+        ptr_vector<char> m_retired;                 // slabs of the layout before the compaction
+        ptr_vector<void> m_free;                    // free lists of blocks of c_align * i bytes
+        char*            m_top = nullptr;
+        char*            m_end = nullptr;
+        size_t           m_slab_size = c_min_slab;  // size of the next slab
+        size_t           m_slab_bytes = 0;          // bytes of the slabs in m_slabs
+        size_t           m_live = 0;                // bytes of live blocks in the slabs
+        bool             m_compacting = false;
+
+        static size_t block_size(size_t bytes) { return (bytes + c_align - 1) & ~static_cast<size_t>(c_align - 1); }
+
+        static void*& next(void* p) { return *static_cast<void**>(p); }
+
+        static void release(ptr_vector<char>& slabs) {
+            for (char* s : slabs)
+                memory::deallocate(s);
+            slabs.reset();
+        }
+
+    public:
+        strip_arena(): m_free(c_max_block / c_align + 1, static_cast<void*>(nullptr)) {}
+        strip_arena(strip_arena const&) = delete;
+        strip_arena& operator=(strip_arena const&) = delete;
+        ~strip_arena() {
+            release(m_slabs);
+            release(m_retired);
+        }
+
+        void* allocate(size_t bytes) {
+            bytes = block_size(bytes);
+            if (bytes > c_max_block)
+                return memory::allocate(bytes);
+            m_live += bytes;
+            void*& head = m_free[bytes / c_align];
+            if (head) {
+                void* r = head;
+                head = next(r);
+                return r;
+            }
+            if (m_top + bytes > m_end) {
+                m_top = static_cast<char*>(memory::allocate(m_slab_size));
+                m_end = m_top + m_slab_size;
+                m_slabs.push_back(m_top);
+                m_slab_bytes += m_slab_size;
+                m_slab_size = std::min<size_t>(2 * m_slab_size, c_max_slab);
+            }
+            void* r = m_top;
+            m_top += bytes;
+            return r;
+        }
+
+        void deallocate(void* p, size_t bytes) {
+            bytes = block_size(bytes);
+            if (bytes > c_max_block) {
+                memory::deallocate(p);
+                return;
+            }
+            m_live -= bytes;
+            // blocks of the old layout go away with their slabs
+            if (m_compacting)
+                return;
+            void*& head = m_free[bytes / c_align];
+            next(p) = head;
+            head = p;
+        }
+
+        /**
+           \brief Return true if less than half of the slab memory is used by live blocks.
+        */
+        bool is_fragmented() const {
+            return m_slabs.size() >= 4 && 2 * m_live < m_slab_bytes;
+        }
+
+        void start_compaction() {
+            SASSERT(!m_compacting);
+            m_retired.append(m_slabs);
+            m_slabs.reset();
+            m_slab_bytes = 0;
+            m_top = m_end = nullptr;
+            for (auto& f : m_free)
+                f = nullptr;
+            m_compacting = true;
+        }
+
+        void end_compaction() {
+            SASSERT(m_compacting);
+            release(m_retired);
+            m_compacting = false;
+        }
+    };
+
+    /**
+       \brief Allocator of the strips of static_matrix. Strips that are copied out
+       of a matrix use the heap, so that they do not depend on the matrix.
+       The arena follows the cells on move assignment and swap, so strips with
+       different arenas can be exchanged.
+    */
+    template <typename T>
+    struct strip_allocator {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        strip_arena* m_arena = nullptr;
+
+        strip_allocator() = default;
+        explicit strip_allocator(strip_arena* a): m_arena(a) {}
+        template <typename U> strip_allocator(strip_allocator<U> const& other) noexcept: m_arena(other.m_arena) {}
+
+        T* allocate(std::size_t n) {
+            size_t bytes = n * sizeof(T);
+            return static_cast<T*>(m_arena ? m_arena->allocate(bytes) : memory::allocate(bytes));
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            if (m_arena)
+                m_arena->deallocate(p, n * sizeof(T));
+            else
+                memory::deallocate(p);
+        }
+
+        strip_allocator select_on_container_copy_construction() const { return strip_allocator(); }
+    };
+
+    template <typename T, typename U>
+    bool operator==(strip_allocator<T> const& a, strip_allocator<U> const& b) { return a.m_arena == b.m_arena; }
+    template <typename T, typename U>
+    bool operator!=(strip_allocator<T> const& a, strip_allocator<U> const& b) { return a.m_arena != b.m_arena; }
+}
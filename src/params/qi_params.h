@@ -36,10 +36,12 @@ struct qi_params {
     unsigned           m_qi_max_lazy_multipattern_matching = 2;
     bool               m_qi_profile = false;
     unsigned           m_qi_profile_freq = UINT_MAX;
+    std::string        m_qi_profile_file;
     quick_checker_mode m_qi_quick_checker = MC_NO;
     bool               m_qi_lazy_quick_checker = true;
     bool               m_qi_promote_unsat = true;
     unsigned           m_qi_max_instances = UINT_MAX;
+    unsigned           m_qi_instance_cache = 0;
     bool               m_qi_lazy_instantiation = false;
     bool               m_qi_conservative_final_check = false;
     bool               m_qe_lite = false;
@@ -51,6 +53,7 @@ struct qi_params {
     bool               m_mbqi_trace = false;
     unsigned           m_mbqi_force_template = 10;
     const char *       m_mbqi_id = nullptr;
+    unsigned           m_mbqi_threads = 1;
 
     qi_params(params_ref const & p = params_ref()):
         /*
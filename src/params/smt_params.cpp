@@ -120,6 +120,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_phase_caching_on);
     DISPLAY_PARAM(m_phase_caching_off);
     DISPLAY_PARAM(m_minimize_lemmas);
+    DISPLAY_PARAM(m_minimize_cache);
     DISPLAY_PARAM(m_max_conflicts);
     DISPLAY_PARAM(m_cube_depth);
     DISPLAY_PARAM(m_threads);
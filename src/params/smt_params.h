@@ -98,6 +98,7 @@ struct smt_params : public preprocessor_params,
     unsigned         m_phase_caching_on = 700;
     unsigned         m_phase_caching_off = 100;
     bool             m_minimize_lemmas = true;
+    bool             m_minimize_cache = true;
     unsigned         m_max_conflicts = UINT_MAX;
     unsigned         m_restart_max;
     unsigned         m_cube_depth = 1;
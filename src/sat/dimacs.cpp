@@ -20,6 +20,17 @@ Revision History:
 #undef max
 #undef min
 #include "sat/sat_solver.h"
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#ifndef _WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 template<typename Buffer>
 static bool is_whitespace(Buffer & in) {
@@ -144,9 +155,194 @@ bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
     return parse_dimacs_core(_in, err, solver);
 }
 
+namespace {
+    /**
+       \brief a part [m_begin, m_end) of a DIMACS file that starts at the beginning of a line.
+    */
+    struct dimacs_chunk {
+        char const* m_begin = nullptr;
+        char const* m_end = nullptr;
+        int_vector  m_lits;                     // literals, each clause is terminated by 0
+        char const* m_err_pos = nullptr;        // first unexpected character
+        char const* m_comment_pos = nullptr;    // first comment before any literal
+        std::exception_ptr m_ex;
+    };
+}
+
+/**
+   \brief tokenize a chunk of a DIMACS file.
+   Comments are only allowed between clauses. A chunk may start inside a clause
+   that is continued from the previous chunk, so the position of a comment that
+   precedes the first literal of the chunk is recorded and checked when the
+   chunks are joined.
+*/
+static void scan_dimacs_chunk(dimacs_chunk& c) {
+    char const* curr = c.m_begin, * end = c.m_end;
+    bool in_clause = false, seen_lit = false;
+    while (curr < end) {
+        char ch = *curr;
+        if ((ch >= 9 && ch <= 13) || ch == 32) {
+            ++curr;
+            continue;
+        }
+        if ((ch == 'c' || ch == 'p') && !in_clause) {
+            if (!seen_lit && !c.m_comment_pos)
+                c.m_comment_pos = curr;
+            curr = static_cast<char const*>(memchr(curr, '\n', end - curr));
+            if (!curr)
+                return;
+            ++curr;
+            continue;
+        }
+        bool neg = ch == '-';
+        if (ch == '-' || ch == '+')
+            ++curr;
+        if (curr == end || *curr < '0' || *curr > '9') {
+            c.m_err_pos = curr;
+            return;
+        }
+        int val = 0;
+        for (; curr < end && *curr >= '0' && *curr <= '9'; ++curr)
+            val = val*10 + (*curr - '0');
+        c.m_lits.push_back(neg ? -val : val);
+        in_clause = val != 0;
+        seen_lit = true;
+    }
+}
+
+bool parse_dimacs(dimacs::mapped_file const& f, std::ostream& err, sat::solver & solver, size_t chunk_size) {
+    // chunks are cut at line boundaries, so tokens never span chunks.
+    // At most one chunk per thread is tokenized ahead of the solver, 
+    // so the literals of only a bounded part of the file are held in memory.
+    unsigned num_threads = std::max(1u, std::thread::hardware_concurrency());
+    char const* begin = f.begin(), * end = f.end();
+
+    auto report = [&](char const* pos) {
+        unsigned line = static_cast<unsigned>(std::count(begin, pos, '\n'));
+        int ch = pos == end ? EOF : static_cast<unsigned char>(*pos);
+        if (20 <= ch && ch < 128) 
+            err << "(error, \"unexpected char: " << ((char)ch) << " line: " << line << "\")\n";
+        else
+            err << "(error, \"unexpected char: " << ch << " line: " << line << "\")\n";
+    };
+
+    sat::literal_vector clause;
+    vector<dimacs_chunk> chunks;
+    char const* curr = begin;
+    while (curr < end) {
+        chunks.reset();
+        for (unsigned i = 0; i < num_threads && curr < end; ++i) {
+            dimacs_chunk c;
+            c.m_begin = curr;
+            if (static_cast<size_t>(end - curr) <= chunk_size)
+                curr = end;
+            else {
+                curr = static_cast<char const*>(memchr(curr + chunk_size, '\n', end - curr - chunk_size));
+                curr = curr ? curr + 1 : end;
+            }
+            c.m_end = curr;
+            chunks.push_back(std::move(c));
+        }
+
+        auto scan = [&](dimacs_chunk& c) {
+            try {
+                scan_dimacs_chunk(c);
+            }
+            catch (...) {
+                c.m_ex = std::current_exception();
+            }
+        };
+        if (chunks.size() == 1)
+            scan(chunks[0]);
+        else {
+            vector<std::thread> threads;
+            for (dimacs_chunk& c : chunks)
+                threads.push_back(std::thread([&]() { scan(c); }));
+            for (auto& th : threads)
+                th.join();
+        }
+        for (dimacs_chunk const& c : chunks)
+            if (c.m_ex)
+                std::rethrow_exception(c.m_ex);
+
+        for (dimacs_chunk& c : chunks) {
+            if (!clause.empty() && c.m_comment_pos) {
+                // a comment inside a clause that continues from the previous chunk.
+                report(c.m_comment_pos);
+                return false;
+            }
+            // clauses of a chunk preceding a lexical error are added, as in the stream parser.
+            for (int l : c.m_lits) {
+                if (l == 0) {
+                    solver.mk_clause(clause.size(), clause.data());
+                    clause.reset();
+                    continue;
+                }
+                unsigned var = static_cast<unsigned>(abs(l));
+                while (var >= solver.num_vars())
+                    solver.mk_var();
+                clause.push_back(sat::literal(var, l < 0));
+            }
+            c.m_lits.finalize();
+            if (c.m_err_pos) {
+                report(c.m_err_pos);
+                return false;
+            }
+        }
+    }
+    if (!clause.empty()) {
+        // the last clause is not terminated by 0.
+        report(end);
+        return false;
+    }
+    return true;
+}
+
 
 namespace dimacs {
 
+    mapped_file::mapped_file(char const* file_name) {
+#ifndef _WINDOWS
+        int fd = open(file_name, O_RDONLY);
+        if (fd >= 0) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+                size_t sz = static_cast<size_t>(st.st_size);
+                void* p = sz == 0 ? nullptr : mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (sz == 0)
+                    m_ok = true;
+                else if (p != MAP_FAILED) {
+                    madvise(p, sz, MADV_SEQUENTIAL);
+                    m_data = static_cast<char const*>(p);
+                    m_size = sz;
+                    m_mapped = true;
+                    m_ok = true;
+                }
+            }
+            close(fd);
+        }
+        if (m_ok)
+            return;
+#endif
+        // pipes and systems without mmap read the contents into memory.
+        std::ifstream in(file_name, std::ios::binary);
+        if (in.bad() || in.fail())
+            return;
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        m_contents = buffer.str();
+        m_data = m_contents.data();
+        m_size = m_contents.size();
+        m_ok = true;
+    }
+
+    mapped_file::~mapped_file() {
+#ifndef _WINDOWS
+        if (m_mapped)
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
     std::ostream& operator<<(std::ostream& out, drat_record const& r) {
         std::function<symbol(int)> fn = [&](int th) { return symbol(th); };
         drat_pp pp(r, fn);
@@ -28,16 +28,53 @@ bool parse_dimacs(std::istream & s, std::ostream& err, sat::solver & solver);
 namespace dimacs {
     struct lex_error : public std::exception {};
 
+    /**
+       \brief read-only view of the contents of a file.
+       The file is memory mapped where available and read into memory otherwise.
+    */
+    class mapped_file {
+        char const* m_data = nullptr;
+        size_t      m_size = 0;
+        bool        m_mapped = false;
+        bool        m_ok = false;
+        std::string m_contents;
+    public:
+        mapped_file(char const* file_name);
+        ~mapped_file();
+        mapped_file(mapped_file const&) = delete;
+        mapped_file& operator=(mapped_file const&) = delete;
+        bool ok() const { return m_ok; }
+        char const* begin() const { return m_data; }
+        char const* end() const { return m_data + m_size; }
+        size_t size() const { return m_size; }
+    };
+
     class stream_buffer {
-        std::istream & m_stream;
+        std::istream * m_stream = nullptr;
+        char const *   m_curr = nullptr;
+        char const *   m_end = nullptr;
         int            m_val;
         unsigned       m_line;
+
+        void next() {
+            if (m_stream)
+                m_val = m_stream->get();
+            else
+                m_val = m_curr < m_end ? static_cast<unsigned char>(*m_curr++) : EOF;
+        }
     public:
         
     stream_buffer(std::istream & s):
-        m_stream(s),
+        m_stream(&s),
             m_line(0) {
-            m_val = m_stream.get();
+            next();
+        }
+
+    stream_buffer(char const* begin, char const* end):
+        m_curr(begin),
+            m_end(end),
+            m_line(0) {
+            next();
         }
         
         int  operator *() const { 
@@ -45,7 +82,7 @@ namespace dimacs {
         }
         
         void operator ++() { 
-            m_val = m_stream.get();
+            next();
             if (m_val == '\n') ++m_line;
         }
         
@@ -87,6 +124,10 @@ namespace dimacs {
             in(_in), err(err)
         {}
 
+        drat_parser(mapped_file const& f, std::ostream& err):
+            in(f.begin(), f.end()), err(err)
+        {}
+
         class iterator {
             drat_parser& p;
             bool m_eof;
@@ -104,3 +145,9 @@ namespace dimacs {
 
     };
 }
+
+/**
+   \brief parse a memory mapped DIMACS file into solver.
+   Large files are tokenized in chunks of about chunk_size bytes by several threads.
+*/
+bool parse_dimacs(dimacs::mapped_file const& f, std::ostream& err, sat::solver & solver, size_t chunk_size = 1 << 24);
@@ -7,95 +7,123 @@ Module Name:
 
 Abstract:
 
-    Small object allocator suitable for clauses
+    Arena allocator for clauses.
+
+    Objects are addressed by 32-bit offsets (even on 64bit machines).
+    Small objects are bump allocated inline in 64KB segments;
+    an offset of a small object is the pair (segment index, word index),
+    where words are 8 bytes. Objects of at least SMALL_OBJ_SIZE bytes
+    are allocated separately and addressed through a slot table;
+    their offsets have the most significant bit set.
+
+    Released small objects are kept in free lists. The arena is
+    compacted by copying live objects into a fresh arena
+    (see solver::defrag_clauses).
 
 Author:
 
     Nikolaj bjorner (nbjorner) 2018-04-26.
 
 Revision History:
+
+    Offset based addressing of clauses.
+
 --*/
 
 #pragma once
 
 #include "util/vector.h"
 #include "util/machine.h"
+#include "util/z3_exception.h"
 
 class sat_allocator {
-    static const unsigned CHUNK_SIZE     = (1 << 16) - sizeof(char*);
+    static const unsigned SEGMENT_BITS   = 16;
+    static const unsigned SEGMENT_SIZE   = 1u << SEGMENT_BITS;
+    static const unsigned WORD_BITS      = SEGMENT_BITS - 3;
+    static const unsigned WORD_MASK      = (1u << WORD_BITS) - 1;
+    static const unsigned MAX_SEGMENTS   = 1u << (31 - WORD_BITS);
+    static const unsigned LARGE_BIT      = 1u << 31;
     static const unsigned SMALL_OBJ_SIZE = 512;
-    static const unsigned MASK = ((1 << PTR_ALIGNMENT) - 1);
-    static const unsigned NUM_FREE = 1 + (SMALL_OBJ_SIZE >> PTR_ALIGNMENT);
-    struct chunk {
-        char  * m_curr;
-        char    m_data[CHUNK_SIZE];
-        chunk():m_curr(m_data) {}
-    };
+    static const unsigned NUM_FREE       = 1 + (SMALL_OBJ_SIZE >> 3);
+
     char const *              m_id;
     size_t                    m_alloc_size;
-    ptr_vector<chunk>         m_chunks;
-    void *                    m_chunk_ptr;
-    ptr_vector<void>          m_free[NUM_FREE];
+    ptr_vector<char>          m_segments;
+    unsigned                  m_top;           // first unused byte in the last segment
+    ptr_vector<char>          m_large;
+    unsigned_vector           m_free_large;
+    unsigned_vector           m_free[NUM_FREE];
+
+    static unsigned num_words(size_t size) { return static_cast<unsigned>((size + 7) >> 3); }
 
-    unsigned align_size(size_t sz) const {
-        return  free_slot_id(sz) << PTR_ALIGNMENT;
-    }
-    unsigned free_slot_id(size_t size) const {
-        return (static_cast<unsigned>(size >> PTR_ALIGNMENT) + ((0 != (size & MASK)) ? 1u : 0u));
-    }
 public:
-    sat_allocator(char const * id = "unknown"): m_id(id), m_alloc_size(0), m_chunk_ptr(nullptr) {}
+    sat_allocator(char const * id = "unknown"): m_id(id), m_alloc_size(0), m_top(SEGMENT_SIZE) {}
     ~sat_allocator() { reset(); }
+
     void reset() {
-        for (chunk * ch : m_chunks) dealloc(ch);
-        m_chunks.reset();
+        for (char * s : m_segments) memory::deallocate(s);
+        for (char * l : m_large) if (l) memory::deallocate(l);
+        m_segments.reset();
+        m_large.reset();
+        m_free_large.reset();
         for (unsigned i = 0; i < NUM_FREE; ++i) m_free[i].reset();
         m_alloc_size = 0;
-        m_chunk_ptr = nullptr;
+        m_top = SEGMENT_SIZE;
     }
-    void * allocate(size_t size) {
+
+    void * get(unsigned off) const {
+        if (off & LARGE_BIT)
+            return m_large[off & ~LARGE_BIT];
+        return m_segments[off >> WORD_BITS] + (static_cast<size_t>(off & WORD_MASK) << 3);
+    }
+
+    void * allocate(size_t size, unsigned & off) {
         m_alloc_size += size;
         if (size >= SMALL_OBJ_SIZE) {
-            return memory::allocate(size);
+            unsigned slot;
+            if (m_free_large.empty()) {
+                slot = m_large.size();
+                m_large.push_back(nullptr);
+            }
+            else {
+                slot = m_free_large.back();
+                m_free_large.pop_back();
+            }
+            m_large[slot] = static_cast<char*>(memory::allocate(size));
+            off = LARGE_BIT | slot;
+            return m_large[slot];
         }
-        unsigned slot_id = free_slot_id(size);
-        if (!m_free[slot_id].empty()) {
-            void* result = m_free[slot_id].back();
-            m_free[slot_id].pop_back();
-            return result;
+        unsigned words = num_words(size);
+        if (!m_free[words].empty()) {
+            off = m_free[words].back();
+            m_free[words].pop_back();
+            return get(off);
         }
-        if (m_chunks.empty()) {
-            m_chunks.push_back(alloc(chunk));
-            m_chunk_ptr = m_chunks.back();
+        if (m_top + (words << 3) > SEGMENT_SIZE) {
+            if (m_segments.size() >= MAX_SEGMENTS)
+                throw default_exception("clause arena is full");
+            m_segments.push_back(static_cast<char*>(memory::allocate(SEGMENT_SIZE)));
+            m_top = 0;
         }
-        
-        unsigned sz = align_size(size);
-        if ((char*)m_chunk_ptr + sz > (char*)m_chunks.back() + CHUNK_SIZE) {
-            m_chunks.push_back(alloc(chunk));
-            m_chunk_ptr = m_chunks.back();            
-        }
-        void * result = m_chunk_ptr;
-        m_chunk_ptr = (char*)m_chunk_ptr + sz;
-        return result;
+        off = ((m_segments.size() - 1) << WORD_BITS) | (m_top >> 3);
+        m_top += words << 3;
+        return get(off);
     }
 
-    void deallocate(size_t size, void * p) {
+    void deallocate(size_t size, unsigned off) {
         m_alloc_size -= size;
-        if (size >= SMALL_OBJ_SIZE) {
-            memory::deallocate(p);
+        if (off & LARGE_BIT) {
+            unsigned slot = off & ~LARGE_BIT;
+            memory::deallocate(m_large[slot]);
+            m_large[slot] = nullptr;
+            m_free_large.push_back(slot);
         }
         else {
-            m_free[free_slot_id(size)].push_back(p);
+            m_free[num_words(size)].push_back(off);
         }
     }
+
     size_t get_allocation_size() const { return m_alloc_size; }
 
     char const* id() const { return m_id; }
 };
-
-inline void * operator new(size_t s, sat_allocator & r) { return r.allocate(s); }
-inline void * operator new[](size_t s, sat_allocator & r) { return r.allocate(s); }
-inline void operator delete(void * p, sat_allocator & r) { UNREACHABLE(); }
-inline void operator delete[](void * p, sat_allocator & r) { UNREACHABLE(); }
-
-
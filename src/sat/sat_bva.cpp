@@ -0,0 +1,328 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_bva.cpp
+
+Abstract:
+
+    Bounded variable addition.
+
+    The replaced clauses are resolvents of the added clauses on the
+    fresh variable. A model of the simplified clauses is therefore a
+    model of the original clauses without further adjustment, and the
+    model converter needs no entry for the added variable.
+    Later eliminations that involve the fresh variable are recorded
+    by the simplifier as usual.
+
+--*/
+
+#include "sat/sat_bva.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    void bva::reserve(unsigned num_vars) {
+        unsigned n = 2 * num_vars;
+        if (m_occs.size() < n) {
+            m_occs.resize(n);
+            m_num_occs.resize(n, 0);
+            m_mark.resize(n, false);
+        }
+    }
+
+    void bva::init() {
+        reserve(s.num_vars());
+        unsigned l_idx = 0;
+        for (watch_list const& wlist : s.m_watches) {
+            literal l1 = ~to_literal(l_idx++);
+            for (watched const& w : wlist) {
+                if (!w.is_binary_non_learned_clause())
+                    continue;
+                literal l2 = w.get_literal();
+                if (l1.index() > l2.index() || s.value(l1) != l_undef || s.value(l2) != l_undef)
+                    continue;
+                m_new.reset();
+                m_new.push_back(l1);
+                m_new.push_back(l2);
+                add(m_new, nullptr);
+            }
+        }
+        for (clause* c : s.m_clauses) {
+            if (c->was_removed() || c->frozen() || c->is_learned())
+                continue;
+            bool is_undef = true;
+            for (literal l : *c)
+                is_undef &= s.value(l) == l_undef;
+            if (!is_undef)
+                continue;
+            m_new.reset();
+            m_new.append(c->size(), c->begin());
+            add(m_new, c);
+        }
+        m_num_original = m_cls.size();
+        for (unsigned i = 0; i < 2 * s.num_vars(); ++i)
+            enqueue(to_literal(i));
+    }
+
+    unsigned bva::add(literal_vector const& lits, clause* origin) {
+        unsigned idx = m_cls.size();
+        m_cls.push_back(lits);
+        m_origin.push_back(origin);
+        m_removed.push_back(false);
+        for (literal l : lits) {
+            m_occs[l.index()].push_back(idx);
+            m_num_occs[l.index()]++;
+        }
+        m_counter -= lits.size();
+        return idx;
+    }
+
+    void bva::remove(unsigned idx) {
+        SASSERT(!m_removed[idx]);
+        m_removed[idx] = true;
+        for (literal l : m_cls[idx])
+            m_num_occs[l.index()]--;
+    }
+
+    void bva::enqueue(literal l) {
+        // a reduction requires at least 3 clauses containing l.
+        if (m_num_occs[l.index()] >= 3)
+            m_queue.push({ m_num_occs[l.index()], l.index() });
+    }
+
+    literal bva::min_occ(literal_vector const& c, literal l) const {
+        literal r = null_literal;
+        for (literal lit : c)
+            if (lit != l && (r == null_literal || m_num_occs[lit.index()] < m_num_occs[r.index()]))
+                r = lit;
+        return r;
+    }
+
+    /**
+       \brief keep one clause of m_matched per set of literals.
+       Duplicate clauses share their partners l2 | C, so they would inflate
+       the reduction, and only the first of them finds a partner to remove.
+    */
+    void bva::dedup_matched() {
+        if (m_matched.size() < 2)
+            return;
+        m_sorted.reset();
+        m_order.reset();
+        for (unsigned cid : m_matched) {
+            m_order.push_back(m_sorted.size());
+            m_sorted.push_back(m_cls[cid]);
+            std::sort(m_sorted.back().begin(), m_sorted.back().end());
+            m_counter -= m_cls[cid].size();
+        }
+        std::sort(m_order.begin(), m_order.end(), [&](unsigned i, unsigned j) {
+            return m_sorted[i] != m_sorted[j] ?
+                std::lexicographical_compare(m_sorted[i].begin(), m_sorted[i].end(), m_sorted[j].begin(), m_sorted[j].end()) :
+                i < j;
+        });
+        // m_sorted[i] is emptied if it duplicates an earlier clause
+        for (unsigned k = m_order.size(); k-- > 1; )
+            if (m_sorted[m_order[k]] == m_sorted[m_order[k - 1]])
+                m_sorted[m_order[k]].reset();
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_matched.size(); ++i)
+            if (!m_sorted[i].empty())
+                m_matched[j++] = m_matched[i];
+        m_matched.shrink(j);
+    }
+
+    /**
+       \brief collect pairs (l2, C) such that C contains l and
+       C with l replaced by l2 is also a clause.
+    */
+    void bva::collect_pairs(literal l) {
+        m_pairs.reset();
+        for (unsigned cid : m_matched) {
+            literal_vector const& c = m_cls[cid];
+            literal lmin = min_occ(c, l);
+            if (lmin == null_literal)
+                continue;
+            for (literal lit : c)
+                if (lit != l)
+                    m_mark[lit.index()] = true;
+            for (unsigned did : m_occs[lmin.index()]) {
+                if (did == cid || m_removed[did])
+                    continue;
+                literal_vector const& d = m_cls[did];
+                if (d.size() != c.size())
+                    continue;
+                m_counter -= d.size();
+                literal other = null_literal;
+                for (literal lit : d) {
+                    if (m_mark[lit.index()])
+                        continue;
+                    if (other != null_literal) {
+                        other = null_literal;
+                        break;
+                    }
+                    other = lit;
+                }
+                if (other == null_literal || other.var() == l.var() || m_lits.contains(other) || m_lits.contains(~other))
+                    continue;
+                m_pairs.push_back({ other.index(), cid });
+            }
+            for (literal lit : c)
+                m_mark[lit.index()] = false;
+        }
+    }
+
+    /**
+       \brief extend L = { l } greedily by the literal that matches the most clauses
+       as long as the reduction in the number of clauses grows.
+    */
+    bool bva::try_reduce(literal l) {
+        m_lits.reset();
+        m_lits.push_back(l);
+        m_matched.reset();
+        for (unsigned idx : m_occs[l.index()])
+            if (!m_removed[idx])
+                m_matched.push_back(idx);
+        dedup_matched();
+        while (m_counter > 0) {
+            collect_pairs(l);
+            if (m_pairs.empty())
+                break;
+            std::sort(m_pairs.begin(), m_pairs.end());
+            unsigned best_lit = UINT_MAX, best_count = 0;
+            for (unsigned i = 0; i < m_pairs.size(); ) {
+                unsigned lit = m_pairs[i].first, count = 0, j = i;
+                for (; j < m_pairs.size() && m_pairs[j].first == lit; ++j)
+                    if (j == i || m_pairs[j].second != m_pairs[j - 1].second)
+                        ++count;
+                if (count > best_count) {
+                    best_count = count;
+                    best_lit = lit;
+                }
+                i = j;
+            }
+            if (reduction(m_lits.size() + 1, best_count) <= reduction(m_lits.size(), m_matched.size()))
+                break;
+            m_lits.push_back(to_literal(best_lit));
+            m_matched.reset();
+            for (auto const& [lit, cid] : m_pairs)
+                if (lit == best_lit && (m_matched.empty() || m_matched.back() != cid))
+                    m_matched.push_back(cid);
+        }
+        return m_lits.size() > 1 && reduction(m_lits.size(), m_matched.size()) > 0;
+    }
+
+    /**
+       \brief find a live clause of the form r | l.
+    */
+    unsigned bva::find(literal_vector const& r, literal l) {
+        for (literal lit : r)
+            m_mark[lit.index()] = true;
+        unsigned result = UINT_MAX;
+        for (unsigned did : m_occs[l.index()]) {
+            literal_vector const& d = m_cls[did];
+            if (m_removed[did] || d.size() != r.size() + 1)
+                continue;
+            m_counter -= d.size();
+            bool match = true;
+            for (literal lit : d)
+                match &= lit == l || m_mark[lit.index()];
+            if (match) {
+                result = did;
+                break;
+            }
+        }
+        for (literal lit : r)
+            m_mark[lit.index()] = false;
+        return result;
+    }
+
+    void bva::replace(literal l) {
+        IF_VERBOSE(10, verbose_stream() << "(sat-bva " << m_lits << " :clauses " << m_matched.size() << ")\n");
+        ++m_num_vars_added;
+        m_num_reduced += reduction(m_lits.size(), m_matched.size());
+        bool_var x = s.mk_var(false, true);
+        reserve(s.num_vars());
+        literal lx(x, false);
+        literal_vector r;
+        for (unsigned cid : m_matched) {
+            r.reset();
+            for (literal lit : m_cls[cid])
+                if (lit != l)
+                    r.push_back(lit);
+            for (unsigned i = 1; i < m_lits.size(); ++i) {
+                unsigned did = find(r, m_lits[i]);
+                SASSERT(did != UINT_MAX);
+                if (did != UINT_MAX)
+                    remove(did);
+            }
+            remove(cid);
+            r.push_back(~lx);
+            add(r, nullptr);
+        }
+        for (literal lit : m_lits) {
+            m_new.reset();
+            m_new.push_back(lit);
+            m_new.push_back(lx);
+            add(m_new, nullptr);
+        }
+        for (literal lit : m_lits)
+            enqueue(lit);
+        enqueue(~lx);
+    }
+
+    /**
+       \brief replace the removed clauses in the solver by the added clauses.
+    */
+    void bva::commit() {
+        bool removed_nary = false;
+        for (unsigned i = 0; i < m_num_original; ++i) {
+            if (!m_removed[i])
+                continue;
+            if (m_origin[i]) {
+                m_origin[i]->set_removed(true);
+                removed_nary = true;
+                continue;
+            }
+            literal l1 = m_cls[i][0], l2 = m_cls[i][1];
+            s.get_wlist(~l1).erase(watched(l2, false));
+            s.get_wlist(~l2).erase(watched(l1, false));
+        }
+        if (removed_nary) {
+            unsigned j = 0;
+            for (clause* c : s.m_clauses) {
+                if (c->was_removed()) {
+                    s.detach_clause(*c);
+                    s.del_clause(*c);
+                }
+                else
+                    s.m_clauses[j++] = c;
+            }
+            s.m_clauses.shrink(j);
+        }
+        for (unsigned i = m_num_original; i < m_cls.size() && !s.inconsistent(); ++i) {
+            if (m_removed[i])
+                continue;
+            m_new = m_cls[i];
+            s.mk_clause_core(m_new.size(), m_new.data(), sat::status::asserted());
+        }
+    }
+
+    void bva::operator()(uint64_t limit) {
+        m_counter = static_cast<int64_t>(limit);
+        init();
+        while (!m_queue.empty() && m_counter > 0) {
+            auto [n, idx] = m_queue.top();
+            m_queue.pop();
+            literal l = to_literal(idx);
+            if (n != m_num_occs[idx]) {
+                enqueue(l);
+                continue;
+            }
+            if (try_reduce(l))
+                replace(l);
+        }
+        commit();
+        m_ticks = static_cast<uint64_t>(static_cast<int64_t>(limit) - m_counter);
+    }
+}
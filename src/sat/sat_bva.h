@@ -0,0 +1,91 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_bva.h
+
+Abstract:
+
+    Bounded variable addition.
+
+    Find a set of literals L and a set of clauses Cs such that
+    the clause l | C is present for every l in L and C in Cs.
+    These |L|*|Cs| clauses are replaced by
+
+        l | x    for l in L
+        C | ~x   for C in Cs
+
+    where x is a fresh variable. Resolving on x produces the
+    replaced clauses, so every model of the new clauses is a model
+    of the old clauses. The transformation pays off when
+    |L|*|Cs| > |L| + |Cs|, which is the case for pairwise
+    at-most-one constraints and product encodings produced by
+    cardinality and pseudo-Boolean encoders.
+
+    Reference: Manthey, Heule, Biere. Automated Reencoding of
+    Boolean Formulas. HVC 2012.
+
+--*/
+#pragma once
+
+#include "sat/sat_types.h"
+#include <queue>
+
+namespace sat {
+    class solver;
+
+    class bva {
+        solver&                  s;
+        vector<literal_vector>   m_cls;          // irredundant clauses, followed by added clauses
+        ptr_vector<clause>       m_origin;       // solver clause, nullptr for binary and added clauses
+        bool_vector              m_removed;
+        unsigned                 m_num_original { 0 };
+        vector<unsigned_vector>  m_occs;         // clause indices per literal, may contain removed clauses
+        unsigned_vector          m_num_occs;     // live occurrences per literal
+        bool_vector              m_mark;         // per literal
+        std::priority_queue<std::pair<unsigned, unsigned>> m_queue;   // (occurrences, literal index)
+        int64_t                  m_counter { 0 };
+        uint64_t                 m_ticks { 0 };
+
+        literal_vector           m_lits;         // the set L
+        unsigned_vector          m_matched;      // clauses l | C for l = m_lits[0] and C in Cs
+        svector<std::pair<unsigned, unsigned>> m_pairs;   // (literal index, clause) candidates to extend L
+        literal_vector           m_new;
+        vector<literal_vector>   m_sorted;       // sorted literals of the clauses in m_matched
+        unsigned_vector          m_order;
+
+        unsigned m_num_vars_added { 0 };
+        unsigned m_num_reduced { 0 };
+
+        static int reduction(unsigned num_lits, unsigned num_cls) {
+            return static_cast<int>(num_lits * num_cls) - static_cast<int>(num_lits + num_cls);
+        }
+
+        void reserve(unsigned num_vars);
+        void init();
+        unsigned add(literal_vector const& lits, clause* origin);
+        void remove(unsigned idx);
+        void enqueue(literal l);
+        literal min_occ(literal_vector const& c, literal l) const;
+        void dedup_matched();
+        void collect_pairs(literal l);
+        bool try_reduce(literal l);
+        void replace(literal l);
+        unsigned find(literal_vector const& r, literal l);
+        void commit();
+
+    public:
+        bva(solver& s): s(s) {}
+
+        /**
+           \brief apply bounded variable addition to the irredundant clauses of s.
+           At most limit literal visits are spent.
+        */
+        void operator()(uint64_t limit);
+
+        unsigned num_vars_added() const { return m_num_vars_added; }
+        unsigned num_reduced() const { return m_num_reduced; }
+        uint64_t ticks() const { return m_ticks; }
+    };
+}
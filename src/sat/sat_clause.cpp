@@ -27,11 +27,13 @@ namespace sat {
         m_id(id),
         m_size(sz),
         m_capacity(sz),
+        m_offset(UINT_MAX),
         m_removed(false),
         m_learned(learned),
         m_used(false),
         m_frozen(false),
         m_reinit_stack(false),
+        m_vivified(false),
         m_inact_rounds(0),
         m_glue(255),
         m_psm(255) {
@@ -115,23 +117,11 @@ namespace sat {
     }
 
     clause_offset clause::get_new_offset() const {
-        unsigned o1 = m_lits[0].index();
-#if defined(__LP64__) || defined(_WIN64)
-        if (sizeof(clause_offset) == 8) {
-            unsigned o2 = m_lits[1].index();
-            return (clause_offset)o1 + (((clause_offset)o2) << 32);
-        }        
-#endif
-        return (clause_offset)o1;
+        return static_cast<clause_offset>(m_lits[0].index());
     }
 
     void clause::set_new_offset(clause_offset offset) {
-        m_lits[0] = to_literal(static_cast<unsigned>(offset));
-#if defined(__LP64__) || defined(_WIN64)
-        if (sizeof(offset) == 8) {
-            m_lits[1] = to_literal(static_cast<unsigned>(offset >> 32));
-        }
-#endif
+        m_lits[0] = to_literal(offset);
     }
 
 
@@ -164,20 +154,12 @@ namespace sat {
         m_allocator.reset();
     }
 
-    clause * clause_allocator::get_clause(clause_offset cls_off) const {
-        SASSERT(cls_off == reinterpret_cast<clause_offset>(reinterpret_cast<clause*>(cls_off)));
-        return reinterpret_cast<clause *>(cls_off);
-    }
-
-    clause_offset clause_allocator::get_offset(clause const * cls) const {
-        SASSERT(cls == reinterpret_cast<clause *>(reinterpret_cast<size_t>(cls)));
-        return reinterpret_cast<size_t>(cls);
-    }
-
     clause * clause_allocator::mk_clause(unsigned num_lits, literal const * lits, bool learned) {
         size_t size = clause::get_obj_size(num_lits);
-        void * mem = m_allocator.allocate(size);
+        clause_offset off;
+        void * mem = m_allocator.allocate(size, off);
         clause * cls = new (mem) clause(m_id_gen.mk(), num_lits, lits, learned);
+        cls->m_offset = off;
         TRACE(sat_clause, tout << "alloc: " << cls->id() << " " << *cls << " " << (learned?"l":"a") << "\n";);
         SASSERT(!learned || cls->is_learned());
         return cls;
@@ -185,12 +167,15 @@ namespace sat {
 
     clause * clause_allocator::copy_clause(clause const& other) {
         size_t size = clause::get_obj_size(other.size());
-        void * mem = m_allocator.allocate(size);
+        clause_offset off;
+        void * mem = m_allocator.allocate(size, off);
         clause * cls = new (mem) clause(m_id_gen.mk(), other.size(), other.m_lits, other.is_learned());
+        cls->m_offset = off;
         cls->m_reinit_stack = other.on_reinit_stack();
         cls->m_glue   = other.glue();
         cls->m_psm    = other.psm();
         cls->m_frozen = other.frozen();
+        cls->m_vivified = other.vivified();
         cls->m_approx = other.approx();
         return cls;
     }
@@ -199,8 +184,9 @@ namespace sat {
         TRACE(sat_clause, tout << "delete: " << cls->id() << " " << *cls << "\n";);
         m_id_gen.recycle(cls->id());
         size_t size = clause::get_obj_size(cls->m_capacity);
+        clause_offset off = cls->m_offset;
         cls->~clause();
-        m_allocator.deallocate(size, cls);
+        m_allocator.deallocate(size, off);
     }
 
     std::ostream & operator<<(std::ostream & out, clause const & c) {
@@ -43,6 +43,7 @@ namespace sat {
         unsigned           m_id;
         unsigned           m_size;
         unsigned           m_capacity;
+        clause_offset      m_offset;
         var_approx_set     m_approx;
         unsigned           m_strengthened:1;
         unsigned           m_removed:1;
@@ -50,6 +51,7 @@ namespace sat {
         unsigned           m_used:1;
         unsigned           m_frozen:1;
         unsigned           m_reinit_stack:1;
+        unsigned           m_vivified:1;
         unsigned           m_inact_rounds:8;
         unsigned           m_glue:8;
         unsigned           m_psm:8;  // transient field used during gc
@@ -103,6 +105,9 @@ namespace sat {
 
         bool on_reinit_stack() const { return m_reinit_stack; }
         void set_reinit_stack(bool f) { m_reinit_stack = f; }
+
+        bool vivified() const { return m_vivified; }
+        void set_vivified(bool f) { m_vivified = f; }
     };
 
     std::ostream & operator<<(std::ostream & out, clause_vector const & cs);
@@ -133,7 +138,8 @@ namespace sat {
     };
 
     /**
-       \brief Simple clause allocator that allows uint (32bit integers) to be used to reference clauses (even in 64bit machines).
+       \brief Clause arena. Clauses are stored inline (header followed by literals)
+       and referenced by 32-bit offsets (even on 64bit machines).
     */
     class clause_allocator {
         sat_allocator    m_allocator;
@@ -142,8 +148,8 @@ namespace sat {
         clause_allocator();
         void          finalize();
         size_t        get_allocation_size() const { return m_allocator.get_allocation_size(); }
-        clause *      get_clause(clause_offset cls_off) const;
-        clause_offset get_offset(clause const * ptr) const;
+        clause *      get_clause(clause_offset cls_off) const { return static_cast<clause*>(m_allocator.get(cls_off)); }
+        clause_offset get_offset(clause const * cls) const { SASSERT(get_clause(cls->m_offset) == cls); return cls->m_offset; }
         clause *      mk_clause(unsigned num_lits, literal const * lits, bool learned);
         clause *      copy_clause(clause const& other);
         void          del_clause(clause * cls);
@@ -84,6 +84,9 @@ namespace sat {
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
+        m_inprocess_schedule = p.inprocess_schedule();
+        m_inprocess_ticks_per_removal = p.inprocess_ticks_per_removal();
+        m_inprocess_max_backoff = p.inprocess_max_backoff();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -96,6 +99,10 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_deterministic = p.threads_deterministic();
+        m_par_sync_conflicts = std::max(1u, p.threads_sync_conflicts());
+        m_par_share_size = p.threads_share_size();
+        m_par_share_glue = p.threads_share_glue();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -168,6 +175,8 @@ namespace sat {
             m_gc_strategy = GC_PSM;
         else if (s == symbol("psm_glue"))
             m_gc_strategy = GC_PSM_GLUE;
+        else if (s == symbol("tier"))
+            m_gc_strategy = GC_TIER;
         else 
             throw sat_param_exception("invalid gc strategy");
         m_gc_initial      = p.gc_initial();
@@ -176,9 +185,17 @@ namespace sat {
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_tier1_glue   = p.gc_tier1_glue();
+        m_gc_tier2_glue   = std::max(m_gc_tier1_glue, p.gc_tier2_glue());
+        m_gc_tier2_rounds = std::min(254u, p.gc_tier2_rounds());
+
+        m_vivify          = p.vivify();
+        m_vivify_glue     = p.vivify_glue();
+        m_vivify_effort   = p.vivify_effort();
 
         m_force_cleanup   = p.force_cleanup();
 
+        m_chrono = p.chrono();
         m_backtrack_scopes = p.backtrack_scopes();
         m_backtrack_init_conflicts = p.backtrack_conflicts();
 
@@ -199,6 +216,7 @@ namespace sat {
              m_smt_proof_check ||
              m_drat_check_sat);
         m_drat_binary     = p.drat_binary();
+        m_drat_async      = p.drat_async();
         m_drat_activity   = p.drat_activity();
         m_dyn_sub_res     = p.dyn_sub_res();
 
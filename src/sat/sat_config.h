@@ -45,7 +45,8 @@ namespace sat {
         GC_PSM,
         GC_GLUE,
         GC_GLUE_PSM,
-        GC_PSM_GLUE
+        GC_PSM_GLUE,
+        GC_TIER
     };
 
     enum branching_heuristic {
@@ -106,12 +107,19 @@ namespace sat {
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
         symbol             m_inprocess_out;
+        bool               m_inprocess_schedule;
+        unsigned           m_inprocess_ticks_per_removal;
+        unsigned           m_inprocess_max_backoff;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        bool               m_par_deterministic;
+        unsigned           m_par_sync_conflicts;
+        unsigned           m_par_share_size;
+        unsigned           m_par_share_glue;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -152,10 +160,18 @@ namespace sat {
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        unsigned           m_gc_tier1_glue;
+        unsigned           m_gc_tier2_glue;
+        unsigned           m_gc_tier2_rounds;
+
+        bool               m_vivify;
+        unsigned           m_vivify_glue;
+        unsigned           m_vivify_effort;
 
         bool               m_force_cleanup;
 
         // backtracking
+        bool               m_chrono;
         unsigned           m_backtrack_scopes;
         unsigned           m_backtrack_init_conflicts;
 
@@ -168,6 +184,7 @@ namespace sat {
         bool               m_drat;
         bool               m_drat_disable;
         bool               m_drat_binary;
+        bool               m_drat_async;
         symbol             m_drat_file;
         bool               m_smt_proof_check;
         bool               m_drat_check_unsat;
@@ -23,8 +23,97 @@ Notes:
 #include "util/rational.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_drat.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace sat {
+
+    /**
+       \brief buffered writer for binary proofs.
+       Proof steps are collected in a buffer that is handed to a background
+       thread when it is full, so search does not wait for the file system.
+       The buffer is guarded by m_buffer_mux, so flush may be called from a
+       timeout handler while the solver is still writing.
+    */
+    class drat::writer {
+        static const unsigned   s_buffer_size = 1 << 20;
+        std::ostream&           m_out;
+        bool                    m_async;
+        std::mutex              m_buffer_mux;
+        svector<char>           m_buffer;      // filled by the solver
+        svector<char>           m_pending;     // written by the background thread
+        bool                    m_has_pending = false;
+        bool                    m_done = false;
+        std::mutex              m_mux;
+        std::condition_variable m_cond;
+        std::thread             m_thread;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_cond.wait(lock, [&]() { return m_has_pending || m_done; });
+                if (!m_has_pending)
+                    break;
+                lock.unlock();
+                m_out.write(m_pending.data(), m_pending.size());
+                lock.lock();
+                m_pending.reset();
+                m_has_pending = false;
+                m_cond.notify_all();
+            }
+        }
+
+        void hand_off() {
+            if (!m_async) {
+                m_out.write(m_buffer.data(), m_buffer.size());
+                m_buffer.reset();
+                return;
+            }
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cond.wait(lock, [&]() { return !m_has_pending; });
+            m_buffer.swap(m_pending);
+            m_has_pending = true;
+            m_cond.notify_all();
+        }
+
+    public:
+        writer(std::ostream& out, bool async): m_out(out), m_async(async) {
+            m_buffer.reserve(s_buffer_size + 64);
+            if (m_async)
+                m_thread = std::thread([this]() { run(); });
+        }
+
+        ~writer() {
+            flush();
+            if (m_async) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mux);
+                    m_done = true;
+                }
+                m_cond.notify_all();
+                m_thread.join();
+            }
+        }
+
+        void write(char const* data, unsigned n) {
+            std::lock_guard<std::mutex> lock(m_buffer_mux);
+            m_buffer.append(n, data);
+            if (m_buffer.size() >= s_buffer_size)
+                hand_off();
+        }
+
+        void flush() {
+            std::lock_guard<std::mutex> lock(m_buffer_mux);
+            if (!m_buffer.empty())
+                hand_off();
+            if (m_async) {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_cond.wait(lock, [&]() { return !m_has_pending; });
+            }
+            m_out.flush();
+        }
+    };
     
     drat::drat(solver& s) :
         s(s)
@@ -32,12 +121,22 @@ namespace sat {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
             m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
-            if (s.get_config().m_drat_binary) 
-                std::swap(m_out, m_bout);            
+            if (s.get_config().m_drat_binary) {
+                std::swap(m_out, m_bout);
+                m_bwriter = alloc(writer, *m_bout, s.get_config().m_drat_async);
+            }
         }
     }
 
+    void drat::flush() {
+        if (m_bwriter) m_bwriter->flush();
+        if (m_out) m_out->flush();
+        if (m_bout) m_bout->flush();
+    }
+
     drat::~drat() {
+        dealloc(m_bwriter);
+        m_bwriter = nullptr;
         if (m_out) m_out->flush();
         if (m_bout) m_bout->flush();
         dealloc(m_out);
@@ -146,14 +245,14 @@ namespace sat {
                 if (v) ch |= 128;
                 buffer[len++] = ch;
                 if (len == sizeof(buffer)) {
-                    m_bout->write(buffer, len);
+                    m_bwriter->write(buffer, len);
                     len = 0;
                 }
             }
             while (v);
         }
         buffer[len++] = 0;
-        m_bout->write(buffer, len);
+        m_bwriter->write(buffer, len);
     }
 
     bool drat::is_cleaned(clause& c) const {
@@ -682,6 +781,8 @@ namespace sat {
         }
         if (m_out)
             dump(sz, lits, st);
+        if (m_bout)
+            bdump(sz, lits, st);
 
         if (m_clause_eh)
             m_clause_eh->on_clause(sz, lits, st);
@@ -46,6 +46,7 @@ namespace sat {
             watched_clause(clause* c, literal l1, literal l2):
                 m_clause(c), m_l1(l1), m_l2(l2) {}
         };
+        class writer;
         clause_eh* m_clause_eh = nullptr;
         svector<watched_clause>   m_watched_clauses;
         typedef svector<unsigned> watch;
@@ -53,6 +54,7 @@ namespace sat {
         clause_allocator        m_alloc;
         std::ostream*           m_out = nullptr;
         std::ostream*           m_bout = nullptr;
+        writer*                 m_bwriter = nullptr;
         svector<std::pair<clause&, status>> m_proof;
         svector<std::pair<literal, clause*>> m_units;
         vector<watch>           m_watches;
@@ -102,6 +104,11 @@ namespace sat {
 
         void updt_config();
 
+        /**
+           \brief Write the buffered proof steps to the proof file.
+        */
+        void flush();
+
         void add();
         void add(literal l, bool learned);
         void add(literal l1, literal l2, status st);
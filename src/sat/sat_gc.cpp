@@ -42,6 +42,10 @@ namespace sat {
         m_gc_threshold += m_config.m_gc_increment;
         IF_VERBOSE(10, verbose_stream() << "(sat.gc)\n";);
         CASSERT("sat_gc_bug", check_invariant());
+        // vivification shrinks clauses before they are ranked, it leaves the solver at the base level.
+        bool reinit = m_config.m_vivify && m_vivify();
+        if (inconsistent())
+            return;
         switch (m_config.m_gc_strategy) {
         case GC_GLUE:
             gc_glue();
@@ -64,6 +68,9 @@ namespace sat {
                 return;
             gc_dyn_psm();
             break;
+        case GC_TIER:
+            gc_tier();
+            break;
         default:
             UNREACHABLE();
             break;
@@ -72,6 +79,8 @@ namespace sat {
         if (gc > 0 && should_defrag()) {
             defrag_clauses();
         }
+        if (reinit)
+            reinit_assumptions();
         CASSERT("sat_gc_bug", check_invariant());
     }
 
@@ -121,6 +130,19 @@ namespace sat {
         }
     };
 
+    /**
+       \brief Lex on (unused since the previous gc, glue, size)
+    */
+    struct used_glue_lt {
+        bool operator()(clause const * c1, clause const * c2) const {
+            bool u1 = c1->inact_rounds() == 0, u2 = c2->inact_rounds() == 0;
+            if (u1 != u2) return u1;
+            if (c1->glue() < c2->glue()) return true;
+            if (c1->glue() > c2->glue()) return false;
+            return c1->size() < c2->size();
+        }
+    };
+
     void solver::gc_glue() {
         std::stable_sort(m_learned.begin(), m_learned.end(), glue_lt());
         gc_half("glue");
@@ -178,6 +200,73 @@ namespace sat {
         IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy " << st_name << " :deleted " << (sz - new_sz) << ")\n";);
     }
 
+    /**
+       \brief Three tier management of learned clauses.
+       Core clauses, of glue at most gc.tier1_glue, are never deleted.
+       Tier2 clauses, of glue at most gc.tier2_glue, are kept as long as they
+       are used at least once in gc.tier2_rounds gc rounds, otherwise they are
+       demoted to local clauses. Local clauses are ranked by whether they were
+       used since the previous gc, glue and size, and the second half is deleted.
+       Clauses are promoted when their glue is recomputed during propagation
+       and conflict analysis.
+    */
+    void solver::gc_tier() {
+        TRACE(sat, tout << "gc\n";);
+        unsigned sz = m_learned.size();
+        unsigned num_core = 0, num_tier2 = 0;
+        clause_vector candidates;
+        unsigned j = 0;
+        for (clause* cp : m_learned) {
+            clause & c = *cp;
+            bool used = c.was_used();
+            c.unmark_used();
+            if (used)
+                c.reset_inact_rounds();
+            else if (c.inact_rounds() < 255)
+                c.inc_inact_rounds();
+            bool keep = c.frozen();
+            switch (glue_tier(c.glue())) {
+            case 0:
+                ++num_core;
+                keep = true;
+                break;
+            case 1:
+                if (c.inact_rounds() <= m_config.m_gc_tier2_rounds) {
+                    ++num_tier2;
+                    keep = true;
+                }
+                else if (c.inact_rounds() == m_config.m_gc_tier2_rounds + 1)
+                    m_stats.m_tier_demotions++;
+                break;
+            default:
+                break;
+            }
+            if (keep)
+                m_learned[j++] = cp;
+            else
+                candidates.push_back(cp);
+        }
+        m_learned.shrink(j);
+        std::stable_sort(candidates.begin(), candidates.end(), used_glue_lt());
+        unsigned half = candidates.size() / 2;
+        for (unsigned i = 0; i < candidates.size(); ++i) {
+            clause & c = *candidates[i];
+            if (i < half || !can_delete(c)) {
+                m_learned.push_back(&c);
+                continue;
+            }
+            detach_clause(c);
+            del_clause(c);
+        }
+        m_stats.m_gc_clause += sz - m_learned.size();
+        m_stats.m_tier_core = num_core;
+        m_stats.m_tier_tier2 = num_tier2;
+        m_stats.m_tier_local = m_learned.size() - num_core - num_tier2;
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy tier :core " << num_core << " :tier2 " << num_tier2
+                   << " :local " << m_stats.m_tier_local << " :promotions " << m_stats.m_tier_promotions
+                   << " :demotions " << m_stats.m_tier_demotions << " :deleted " << (sz - m_learned.size()) << ")\n";);
+    }
+
     bool solver::can_delete(clause const & c) const {
         if (c.on_reinit_stack())
             return false;
@@ -0,0 +1,142 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.cpp
+
+Abstract:
+
+    Scheduler for inprocessing techniques.
+
+--*/
+
+#include "sat/sat_inprocess.h"
+#include "sat/sat_solver.h"
+#include <iomanip>
+
+namespace sat {
+
+    // statistics keys are not copied, so they are kept in a static table.
+    static struct technique_names {
+        char const* m_name;
+        char const* m_calls;
+        char const* m_skipped;
+        char const* m_effective;
+        char const* m_ticks;
+        char const* m_removed;
+    } const s_names[inprocess::num_techniques] = {
+        { "scc", "sat inprocess scc calls", "sat inprocess scc skipped", "sat inprocess scc effective",
+          "sat inprocess scc ticks", "sat inprocess scc removed" },
+        { "simplify", "sat inprocess simplify calls", "sat inprocess simplify skipped", "sat inprocess simplify effective",
+          "sat inprocess simplify ticks", "sat inprocess simplify removed" },
+        { "simplify-learned", "sat inprocess simplify-learned calls", "sat inprocess simplify-learned skipped", "sat inprocess simplify-learned effective",
+          "sat inprocess simplify-learned ticks", "sat inprocess simplify-learned removed" },
+        { "probing", "sat inprocess probing calls", "sat inprocess probing skipped", "sat inprocess probing effective",
+          "sat inprocess probing ticks", "sat inprocess probing removed" },
+        { "asymm-branch", "sat inprocess asymm-branch calls", "sat inprocess asymm-branch skipped", "sat inprocess asymm-branch effective",
+          "sat inprocess asymm-branch ticks", "sat inprocess asymm-branch removed" },
+        { "lookahead", "sat inprocess lookahead calls", "sat inprocess lookahead skipped", "sat inprocess lookahead effective",
+          "sat inprocess lookahead ticks", "sat inprocess lookahead removed" },
+        { "anf", "sat inprocess anf calls", "sat inprocess anf skipped", "sat inprocess anf effective",
+          "sat inprocess anf ticks", "sat inprocess anf removed" },
+    };
+
+    uint64_t inprocess::ticks() const {
+        stats const& st = s.m_stats;
+        return static_cast<uint64_t>(st.m_propagate) + st.m_bin_propagate + st.m_ter_propagate + s.m_simplifier.ticks();
+    }
+
+    // techniques run at base level, where every assigned variable is on the trail.
+    unsigned inprocess::num_active_vars() const {
+        SASSERT(s.at_base_lvl());
+        unsigned removed = s.num_eliminated() + s.m_trail.size();
+        return removed < s.num_vars() ? s.num_vars() - removed : 0;
+    }
+
+    bool inprocess::begin(technique t) {
+        SASSERT(m_current == num_techniques);
+        entry& e = m_entries[t];
+        if (s.m_config.m_inprocess_schedule && e.m_delay > 0) {
+            --e.m_delay;
+            ++e.m_skipped;
+            return false;
+        }
+        m_current = t;
+        m_ticks0 = ticks();
+        m_vars0 = num_active_vars();
+        m_clauses0 = s.num_clauses();
+        return true;
+    }
+
+    void inprocess::end(uint64_t extra_ticks) {
+        SASSERT(m_current != num_techniques);
+        entry& e = m_entries[m_current];
+        m_current = num_techniques;
+        uint64_t t = ticks() - m_ticks0 + extra_ticks;
+        unsigned vars = num_active_vars();
+        unsigned clauses = s.num_clauses();
+        uint64_t removed = 0;
+        if (vars < m_vars0)
+            removed += m_vars0 - vars;
+        if (clauses < m_clauses0)
+            removed += m_clauses0 - clauses;
+        if (t == 0 && removed == 0)
+            return;     // the technique throttled itself
+        ++e.m_calls;
+        e.m_ticks += t;
+        e.m_removed += removed;
+        if (s.inconsistent() || (removed > 0 && t <= removed * s.m_config.m_inprocess_ticks_per_removal)) {
+            ++e.m_effective;
+            e.m_backoff = 1;
+            e.m_delay = 0;
+        }
+        else {
+            e.m_delay = e.m_backoff;
+            e.m_backoff = std::min(2 * e.m_backoff, std::max(1u, s.m_config.m_inprocess_max_backoff));
+        }
+    }
+
+    void inprocess::init_search() {
+        m_current = num_techniques;
+    }
+
+    void inprocess::collect_statistics(statistics& st) const {
+        for (unsigned i = 0; i < num_techniques; ++i) {
+            entry const& e = m_entries[i];
+            technique_names const& n = s_names[i];
+            if (e.m_calls == 0 && e.m_skipped == 0)
+                continue;
+            st.update(n.m_calls, e.m_calls);
+            st.update(n.m_skipped, e.m_skipped);
+            st.update(n.m_effective, e.m_effective);
+            st.update(n.m_ticks, static_cast<double>(e.m_ticks));
+            st.update(n.m_removed, static_cast<double>(e.m_removed));
+        }
+    }
+
+    void inprocess::reset_statistics() {
+        for (entry& e : m_entries) {
+            e.m_calls = 0;
+            e.m_skipped = 0;
+            e.m_effective = 0;
+            e.m_ticks = 0;
+            e.m_removed = 0;
+        }
+    }
+
+    std::ostream& inprocess::display(std::ostream& out) const {
+        out << "(sat-inprocess\n";
+        for (unsigned i = 0; i < num_techniques; ++i) {
+            entry const& e = m_entries[i];
+            out << "  " << std::setw(17) << std::left << s_names[i].m_name << std::right
+                << " :calls " << std::setw(5) << e.m_calls
+                << " :skipped " << std::setw(5) << e.m_skipped
+                << " :effective " << std::setw(5) << e.m_effective
+                << " :ticks " << std::setw(10) << e.m_ticks
+                << " :removed " << std::setw(7) << e.m_removed
+                << " :ticks/removed " << std::setw(8) << (e.m_removed == 0 ? e.m_ticks : e.m_ticks / e.m_removed) << "\n";
+        }
+        return out << ")\n";
+    }
+}
@@ -0,0 +1,83 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.h
+
+Abstract:
+
+    Scheduler for inprocessing techniques.
+
+    Each technique invoked by solver::do_simplify is metered in ticks,
+    where a tick is a propagated literal or a unit of work reported
+    by the technique. The scheduler records how many variables and
+    clauses each call removes. Techniques that use many ticks per
+    removal are skipped for an exponentially growing number of
+    simplification rounds, and run again every round once they
+    become effective.
+
+--*/
+#pragma once
+
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+    class solver;
+
+    class inprocess {
+    public:
+        enum technique {
+            scc_t,
+            simplify_t,
+            simplify_learned_t,
+            probing_t,
+            asymm_branch_t,
+            lookahead_t,
+            anf_t,
+            num_techniques
+        };
+
+    private:
+        struct entry {
+            unsigned m_calls { 0 };
+            unsigned m_skipped { 0 };
+            unsigned m_effective { 0 };
+            uint64_t m_ticks { 0 };
+            uint64_t m_removed { 0 };
+            unsigned m_backoff { 1 };   // rounds to skip after the next ineffective call
+            unsigned m_delay { 0 };     // rounds left to skip
+        };
+
+        solver&   s;
+        entry     m_entries[num_techniques];
+        technique m_current { num_techniques };
+        uint64_t  m_ticks0 { 0 };
+        unsigned  m_vars0 { 0 };
+        unsigned  m_clauses0 { 0 };
+
+        uint64_t ticks() const;
+        unsigned num_active_vars() const;
+
+    public:
+        inprocess(solver& s): s(s) {}
+
+        /**
+           \brief start metering technique t.
+           Return false if t is skipped in the current round.
+        */
+        bool begin(technique t);
+
+        /**
+           \brief stop metering the current technique.
+           extra_ticks is added for work that does not involve propagation.
+        */
+        void end(uint64_t extra_ticks = 0);
+
+        void init_search();
+        void collect_statistics(statistics& st) const;
+        void reset_statistics();
+        std::ostream& display(std::ostream& out) const;
+    };
+}
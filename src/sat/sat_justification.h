@@ -46,7 +46,7 @@ namespace sat {
         literal get_literal() const { SASSERT(is_binary_clause()); return to_literal(val1()); }
 
         bool is_clause() const { return m_val2 == CLAUSE; }
-        clause_offset get_clause_offset() const { return m_val1; }
+        clause_offset get_clause_offset() const { return static_cast<clause_offset>(m_val1); }
         
         bool is_ext_justification() const { return m_val2 == EXT_JUSTIFICATION; }
         ext_justification_idx get_ext_justification_idx() const { return m_val1; }
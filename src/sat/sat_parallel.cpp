@@ -22,69 +22,103 @@ Revision History:
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        index = (n >= m_size) ? 0 : n;
+    void parallel::clause_ring::reserve(unsigned sz) {
+        unsigned cap = 1;
+        while (cap < sz) 
+            cap *= 2;
+        m_mask = cap - 1;
+        m_data = std::make_unique<std::atomic<unsigned>[]>(cap);
+        m_tail = 0;
+        m_reserved = 0;
+        m_num_exported = 0;
+        m_num_filtered = 0;
     }
 
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
+    void parallel::clause_ring::push(unsigned n, literal const* lits) {
+        SASSERT(n + 1 <= capacity());
+        uint64_t t = m_tail.load(std::memory_order_relaxed);
+        uint64_t end = t + n + 1;
+        // announce the region that gets overwritten before writing it.
+        m_reserved.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_data[t & m_mask].store(n, std::memory_order_relaxed);
+        for (unsigned i = 0; i < n; ++i)
+            m_data[(t + 1 + i) & m_mask].store(lits[i].index(), std::memory_order_relaxed);
+        m_tail.store(end, std::memory_order_release);
+        ++m_num_exported;
     }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
+
+    /**
+       \brief read the clause at position pos. 
+       The entry is validated after it is read: if the writer reserved a region that
+       overlaps the entry in the meantime, the entry is discarded and the reader skips
+       to the current tail.
+    */
+    bool parallel::clause_ring::read(uint64_t& pos, literal_vector& lits, unsigned& num_overruns) const {
+        while (true) {
+            uint64_t t = m_tail.load(std::memory_order_acquire);
+            if (pos >= t)
+                return false;
+            if (t - pos > capacity()) {
+                ++num_overruns;
+                pos = t;
+                return false;
+            }
+            unsigned n = m_data[pos & m_mask].load(std::memory_order_relaxed);
+            bool valid = pos + 1 + n <= t;
+            lits.reset();
+            for (unsigned i = 0; valid && i < n; ++i)
+                lits.push_back(to_literal(m_data[(pos + 1 + i) & m_mask].load(std::memory_order_relaxed)));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (valid && m_reserved.load(std::memory_order_relaxed) <= pos + capacity()) {
+                pos += n + 1;
+                return true;
             }
-            m_at_end[i] = false;
+            ++num_overruns;
+            pos = m_tail.load(std::memory_order_acquire);
         }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
     }
 
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
-    }
-
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) 
-            m_tail = 0;
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_rings.reset();
+        m_readers.reset();
+        for (unsigned i = 0; i < num_owners; ++i) {
+            m_rings.push_back(alloc(clause_ring));
+            m_rings.back()->reserve(sz);
+        }
+        m_readers.resize(num_owners);
+        for (reader_state& r : m_readers)
+            r.m_pos.resize(num_owners, 0);
+        m_max_share_size = m_rings.empty() ? 0 : m_rings[0]->capacity() / 8;
     }
 
-
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
-                return true;
-            }
-            head = m_heads[owner];
+    void parallel::collect_statistics(statistics& st) const {
+        unsigned exported = 0, filtered = 0, imported = 0, overruns = 0;
+        for (clause_ring* r : m_rings) {
+            exported += r->m_num_exported;
+            filtered += r->m_num_filtered;
         }
-        return false;
+        for (reader_state const& r : m_readers) {
+            imported += r.m_num_imported;
+            overruns += r.m_num_overruns;
+        }
+        st.update("sat parallel exported clauses", exported);
+        st.update("sat parallel filtered clauses", filtered);
+        st.update("sat parallel imported clauses", imported);
+        st.update("sat parallel ring overruns", overruns);
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): 
+        m_deterministic(false),
+        m_num_workers(0),
+        m_num_arrived(0),
+        m_epoch(0),
+        m_finished_id(-1),
+        m_finished_result(l_undef),
+        m_winner(-1),
+        m_num_clauses(0), 
+        m_consumer_ready(false), 
+        m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         reset();
@@ -123,7 +157,7 @@ namespace sat {
 
 
     void parallel::exchange(solver& s, literal_vector const& in, unsigned& limit, literal_vector& out) {
-        if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
+        if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses || m_deterministic) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         {
             lock_guard lock(m_mux);
@@ -146,58 +180,168 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        if (m_deterministic) {
+            unsigned_vector& out = m_outbox[s.m_par_id].m_clauses;
+            out.push_back(2);
+            out.push_back(l1.index());
+            out.push_back(l2.index());
+            m_rings[s.m_par_id]->m_num_exported++;
+            return;
+        }
+        literal lits[2] = { l1, l2 };
+        m_rings[s.m_par_id]->push(2, lits);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
-        if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
+        if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
+        if (!enable_add(s, c)) {
+            m_rings[s.m_par_id]->m_num_filtered++;
+            return;
+        }
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         unsigned n = c.size();
         unsigned owner = s.m_par_id;
         IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) 
-            m_pool.add_vector_elem(c[i].index());
-        m_pool.end_add_vector();        
+        if (m_deterministic) {
+            unsigned_vector& out = m_outbox[owner].m_clauses;
+            out.push_back(n);
+            for (literal lit : c)
+                out.push_back(lit.index());
+            m_rings[owner]->m_num_exported++;
+            return;
+        }
+        m_rings[owner]->push(n, c.begin());
     }
 
     void parallel::get_clauses(solver& s) {
-        if (s.m_par_syncing_clauses) return;
+        if (s.m_par_syncing_clauses || m_deterministic) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
         _get_clauses(s);        
     }
 
     void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
+        reader_state& r = m_readers[owner];
+        for (unsigned id = 0; id < m_rings.size() && !s.inconsistent(); ++id) {
+            if (id == owner)
+                continue;
+            while (!s.inconsistent() && m_rings[id]->read(r.m_pos[id], r.m_lits, r.m_num_overruns)) {
+                bool usable_clause = true;
+                for (literal lit : r.m_lits)
+                    usable_clause &= lit.var() < s.m_par_num_vars && !s.was_eliminated(lit.var());
+                IF_VERBOSE(3, verbose_stream() << owner << ": retrieve " << r.m_lits << "\n";);
+                SASSERT(r.m_lits.size() >= 2);
+                if (usable_clause) {
+                    ++r.m_num_imported;
+                    s.mk_clause_core(r.m_lits.size(), r.m_lits.data(), sat::status::redundant());
+                }
+            }
+        }
+    }
+
+    void parallel::init_deterministic(unsigned num_workers) {
+        m_deterministic = true;
+        m_num_workers = num_workers;
+        m_num_arrived = 0;
+        m_epoch = 0;
+        m_finished_id = -1;
+        m_finished_result = l_undef;
+        m_winner = -1;
+        m_outbox.reset();
+        m_inbox.reset();
+        m_outbox.resize(num_workers);
+        m_inbox.resize(num_workers);
+    }
+
+    /**
+       \brief Barrier of the deterministic mode. 
+       The last solver to arrive publishes the exported clauses and units of the round
+       and decides whether search stops. If several solvers finished during the round, 
+       the result of the solver with the smallest identifier is used. 
+       The outcome therefore depends only on the number of conflicts of each solver
+       and not on thread scheduling.
+    */
+    bool parallel::barrier(unsigned id, bool finished, lbool r) {
+        std::unique_lock<std::mutex> lock(m_sync_mux);
+        if (m_winner != -1)
+            return false;
+        if (finished && (m_finished_id == -1 || static_cast<int>(id) < m_finished_id)) {
+            m_finished_id = id;
+            m_finished_result = r;
+        }
+        unsigned epoch = m_epoch;
+        if (++m_num_arrived == m_num_workers) {
+            m_num_arrived = 0;
+            ++m_epoch;
+            m_winner = m_finished_id;
+            m_inbox.swap(m_outbox);
+            for (outbox& o : m_outbox)
+                o.reset();
+            IF_VERBOSE(2, verbose_stream() << "(sat-parallel-sync :round " << m_epoch << ")\n");
+            m_sync_cv.notify_all();
+        }
+        else 
+            m_sync_cv.wait(lock, [&]() { return m_epoch != epoch; });
+        return m_winner == -1;
+    }
+
+    bool parallel::sync(solver& s, literal_vector const& units) {
+        SASSERT(m_deterministic);
+        m_outbox[s.m_par_id].m_units.append(units);
+        if (!barrier(s.m_par_id, false, l_undef))
+            return false;
+        import(s);
+        return true;
+    }
+
+    void parallel::finish(solver& s, lbool r) {
+        SASSERT(m_deterministic);
+        barrier(s.m_par_id, true, r);
+    }
+
+    /**
+       \brief import units and clauses exported by other solvers in the previous round.
+       The inbox is not modified until every solver arrives at the next barrier.
+    */
+    void parallel::import(solver& s) {
+        flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
+        unsigned owner = s.m_par_id;
+        reader_state& r = m_readers[owner];
+        literal_vector& lits = r.m_lits;
+        for (unsigned id = 0; id < m_num_workers && !s.inconsistent(); ++id) {
+            if (id == owner)
+                continue;
+            for (literal lit : m_inbox[id].m_units) {
+                if (s.inconsistent())
+                    break;
+                if (lit.var() < s.m_par_num_vars && !s.was_eliminated(lit.var()) && (s.lvl(lit.var()) != 0 || s.value(lit) != l_true))
+                    s.assign_unit(lit);
             }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
-            if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+            unsigned_vector const& cls = m_inbox[id].m_clauses;
+            for (unsigned i = 0; i < cls.size() && !s.inconsistent(); ) {
+                unsigned n = cls[i++];
+                lits.reset();
+                bool usable_clause = true;
+                for (unsigned j = 0; j < n; ++j) {
+                    literal lit(to_literal(cls[i + j]));
+                    lits.push_back(lit);
+                    usable_clause &= lit.var() < s.m_par_num_vars && !s.was_eliminated(lit.var());
+                }
+                i += n;
+                if (usable_clause) {
+                    ++r.m_num_imported;
+                    s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
+                }
             }
-        }        
+        }
     }
 
-    bool parallel::enable_add(clause const& c) const {
+    bool parallel::enable_add(solver& s, clause const& c) const {
         // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        auto const& cfg = s.get_config();
+        if (!m_deterministic && c.size() > m_max_share_size)
+            return false;
+        return (c.size() <= cfg.m_par_share_size && c.glue() <= cfg.m_par_share_glue) || c.glue() <= 2;
     }
 
     void parallel::_from_solver(solver& s) {
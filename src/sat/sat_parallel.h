@@ -24,31 +24,41 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include "util/statistics.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 
 namespace sat {
 
     class parallel {
 
-        // shared pool of learned clauses.
-        class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+        // Clauses exported by one solver.
+        // The owner is the only writer; other solvers read at their own pace without locking.
+        // Positions grow monotonically; a clause is stored as its size followed by literal indices.
+        // A reader that falls more than the capacity behind skips to the most recent position.
+        class clause_ring {
+            unsigned                                 m_mask { 0 };
+            std::unique_ptr<std::atomic<unsigned>[]> m_data;
+            std::atomic<uint64_t>                    m_tail { 0 };      // end of published clauses
+            std::atomic<uint64_t>                    m_reserved { 0 };  // end of clause being written
         public:
-            void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            unsigned m_num_exported { 0 };
+            unsigned m_num_filtered { 0 };
+            void reserve(unsigned sz);
+            unsigned capacity() const { return m_mask + 1; }
+            void push(unsigned n, literal const* lits);
+            bool read(uint64_t& pos, literal_vector& lits, unsigned& num_overruns) const;
         };
 
-        bool enable_add(clause const& c) const;
+        struct reader_state {
+            svector<uint64_t> m_pos;            // read position for each ring
+            literal_vector    m_lits;
+            unsigned          m_num_imported { 0 };
+            unsigned          m_num_overruns { 0 };
+        };
+
+        bool enable_add(solver& s, clause const& c) const;
         void _get_clauses(solver& s);
         void _from_solver(solver& s);
         void _to_solver(solver& s);
@@ -58,10 +68,33 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
+        scoped_ptr_vector<clause_ring> m_rings;
+        vector<reader_state>           m_readers;
+        unsigned                       m_max_share_size { 0 };
         mutex          m_mux;
 
+        // deterministic mode: clauses and units are exchanged only at barriers
+        // and imported in the order of solver identifiers.
+        struct outbox {
+            unsigned_vector m_clauses;  // sequence of (size, literal indices)
+            literal_vector  m_units;
+            void reset() { m_clauses.reset(); m_units.reset(); }
+        };
+        bool                    m_deterministic;
+        unsigned                m_num_workers;
+        unsigned                m_num_arrived;
+        unsigned                m_epoch;
+        int                     m_finished_id;
+        lbool                   m_finished_result;
+        int                     m_winner;
+        vector<outbox>          m_outbox;
+        vector<outbox>          m_inbox;
+        std::mutex              m_sync_mux;
+        std::condition_variable m_sync_cv;
+
+        bool barrier(unsigned id, bool finished, lbool r);
+        void import(solver& s);
+
         // for exchange with local search:
         unsigned           m_num_clauses;
         scoped_ptr<solver> m_solver_copy;
@@ -84,8 +117,8 @@ namespace sat {
 
         void push_child(reslimit& rl);
 
-        // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        // reserve a ring of sz entries for each solver
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -102,6 +135,21 @@ namespace sat {
         // receive clauses from shared clause pool
         void get_clauses(solver& s);
 
+        // deterministic mode
+        void init_deterministic(unsigned num_workers);
+
+        bool is_deterministic() const { return m_deterministic; }
+
+        // wait until all solvers reach the barrier, then import clauses and units exported
+        // by the other solvers. Returns false if some solver finished and search should stop.
+        bool sync(solver& s, literal_vector const& units);
+
+        // report the result of a solver. Blocks until the barrier of the current round is complete.
+        void finish(solver& s, lbool r);
+
+        // the solver whose result is used, -1 if none finished.
+        int winner() const { return m_winner; }
+
         // exchange from solver state to local search and back.
         void from_solver(solver& s);
         void to_solver(solver& s);
@@ -110,6 +158,8 @@ namespace sat {
         void to_solver(i_local_search& s);
         
         bool copy_solver(solver& s);
+
+        void collect_statistics(statistics& st) const;
     };
 
 }
@@ -22,6 +22,7 @@ Revision History:
 #include "sat/sat_simplifier_params.hpp"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
+#include "sat/sat_bva.h"
 #include "util/stopwatch.h"
 #include "util/trace.h"
 
@@ -61,7 +62,8 @@ namespace sat {
 
     simplifier::simplifier(solver & _s, params_ref const & p):
         s(_s),
-        m_num_calls(0) {
+        m_num_calls(0),
+        m_ticks(0) {
         updt_params(p);
         reset_statistics();
     }
@@ -114,6 +116,11 @@ namespace sat {
         return !m_incremental_mode && !s.tracking_assumptions() && m_elim_vars && single_threaded(); 
     }    
 
+    bool simplifier::bva_enabled() const {
+        return !m_incremental_mode && !s.tracking_assumptions() && m_bva && single_threaded() && 
+            !s.m_ext && !s.m_config.m_drat && s.num_user_scopes() == 0;
+    }
+
     void simplifier::register_clauses(clause_vector & cs) {
         std::stable_sort(cs.begin(), cs.end(), size_lt());
         for (clause* c : cs) {
@@ -240,6 +247,8 @@ namespace sat {
             ++count;
         }
         while (!m_sub_todo.empty() && count < 20);
+        m_ticks += std::max(0ll, static_cast<long long>(m_subsumption_limit) - m_sub_counter);
+        m_ticks += std::max(0ll, static_cast<long long>(m_res_limit) - m_elim_counter);
         bool vars_eliminated = m_num_elim_vars > m_old_num_elim_vars;
 
         if (m_need_cleanup || vars_eliminated) {
@@ -251,6 +260,9 @@ namespace sat {
             cleanup_clauses(s.m_clauses, false, vars_eliminated);
         }
 
+        if (!learned && bva_enabled())
+            bounded_var_addition();
+
         CASSERT("sat_solver", s.check_invariant());
         TRACE(sat_simplifier, s.display(tout); tout << "model_converter:\n"; s.m_mc.display(tout););
 
@@ -2092,6 +2104,22 @@ namespace sat {
         m_new_cls.finalize();
     }
 
+    void simplifier::bounded_var_addition() {
+        stopwatch watch;
+        watch.start();
+        sat::bva b(s);
+        b(m_bva_limit);
+        m_num_bva_vars += b.num_vars_added();
+        m_num_bva_reduced += b.num_reduced();
+        m_ticks += b.ticks();
+        watch.stop();
+        IF_VERBOSE(SAT_VB_LVL,
+                   verbose_stream() << " (sat-bva :vars " << b.num_vars_added()
+                   << " :reduced " << b.num_reduced()
+                   << mem_stat()
+                   << " :time " << std::fixed << std::setprecision(2) << watch.get_seconds() << ")\n";);
+    }
+
     void simplifier::updt_params(params_ref const & _p) {
         sat_simplifier_params p(_p);
         m_cce                     = p.cce();
@@ -2117,6 +2145,8 @@ namespace sat {
         m_subsumption             = p.subsumption();
         m_subsumption_limit       = p.subsumption_limit();
         m_elim_vars               = p.elim_vars();
+        m_bva                     = p.bva();
+        m_bva_limit               = p.bva_limit();
         m_incremental_mode        = s.get_config().m_incremental && !p.override_incremental();
     }
 
@@ -2134,6 +2164,8 @@ namespace sat {
         st.update("sat abce", m_num_abce);
         st.update("sat bca",  m_num_bca);
         st.update("sat ate",  m_num_ate);
+        st.update("sat bva vars", m_num_bva_vars);
+        st.update("sat bva reduced clauses", m_num_bva_reduced);
     }
 
     void simplifier::reset_statistics() {
@@ -2147,5 +2179,7 @@ namespace sat {
         m_num_elim_vars = 0;
         m_num_bca = 0;
         m_num_ate = 0;
+        m_num_bva_vars = 0;
+        m_num_bva_reduced = 0;
     }
 }
@@ -75,6 +75,7 @@ namespace sat {
         // counters
         int                    m_sub_counter;
         int                    m_elim_counter;
+        uint64_t               m_ticks;   // work spent by subsumption and elimination
 
         // config
         bool                   m_abce; // block clauses using asymmetric added literals
@@ -103,6 +104,8 @@ namespace sat {
         bool                   m_subsumption;
         unsigned               m_subsumption_limit;
         bool                   m_elim_vars;
+        bool                   m_bva;
+        unsigned               m_bva_limit;
         bool                   m_elim_vars_bdd;
         unsigned               m_elim_vars_bdd_delay;
 
@@ -117,6 +120,8 @@ namespace sat {
         unsigned               m_num_elim_vars;
         unsigned               m_num_sub_res;
         unsigned               m_num_elim_lits;
+        unsigned               m_num_bva_vars;
+        unsigned               m_num_bva_reduced;
 
         bool                   m_learned_in_use_lists;
         unsigned               m_old_num_elim_vars;
@@ -190,6 +195,7 @@ namespace sat {
         bool bca_enabled()  const;
         bool elim_vars_bdd_enabled() const;
         bool elim_vars_enabled() const;
+        bool bva_enabled() const;
 
         unsigned num_nonlearned_bin(literal l) const;
         unsigned get_to_elim_cost(bool_var v) const;
@@ -205,6 +211,7 @@ namespace sat {
         void remove_clauses(clause_use_list const & cs, literal l);
         bool try_eliminate(bool_var v);
         void elim_vars();
+        void bounded_var_addition();
 
         struct blocked_cls_report;
         struct subsumption_report;
@@ -224,6 +231,8 @@ namespace sat {
 
         void init_search() { m_num_calls = 0; }
 
+        uint64_t ticks() const { return m_ticks; }
+
         void insert_elim_todo(bool_var v) { m_elim_todo.insert(v); }
 
         void reset_todos() {
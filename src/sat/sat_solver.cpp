@@ -52,6 +52,8 @@ namespace sat {
         m_scc(*this, p),
         m_asymm_branch(*this, p),
         m_probing(*this, p),
+        m_inprocess(*this),
+        m_vivify(*this),
         m_mus(*this),
         m_inconsistent(false),
         m_searching(false),
@@ -124,6 +126,7 @@ namespace sat {
         m_justification.reset();
         m_decision.reset();
         m_eliminated.reset();
+        m_num_eliminated = 0;
         m_external.reset();
         m_var_scope.reset();
         m_activity.reset();
@@ -260,6 +263,8 @@ namespace sat {
         m_assignment[2*v+1] = l_undef;
         m_justification[v] = justification(UINT_MAX);
         m_decision[v] = dvar;
+        if (m_eliminated[v])
+            --m_num_eliminated;
         m_eliminated[v] = false;
         m_external[v] = ext;
         m_var_scope[v] = scope_lvl();
@@ -341,8 +346,11 @@ namespace sat {
             return;
         if (!f) 
             reset_var(v, m_external[v], m_decision[v]);
-        else if (f && m_ext)
-            m_ext->set_eliminated(v);
+        else {
+            if (m_ext)
+                m_ext->set_eliminated(v);
+            ++m_num_eliminated;
+        }
         m_eliminated[v] = f; 
     }
 
@@ -1024,11 +1032,14 @@ namespace sat {
     void solver::propagate_clause(clause& c, bool update, unsigned assign_level, clause_offset cls_off) {
         unsigned glue;
         SASSERT(value(c[0]) == l_undef); 
-            m_stats.m_propagate++;          
+            if (c.size() == 3)
+                m_stats.m_ter_propagate++;
+            else
+                m_stats.m_propagate++;          
             c.mark_used();                                          
             assign_core(c[0], justification(assign_level, cls_off)); 
             if (update && c.is_learned() && c.glue() > 2 && num_diff_levels_below(c.size(), c.begin(), c.glue() - 1, glue)) 
-                c.set_glue(glue);                                   \
+                update_glue(c, glue);
     }
 
     void solver::set_watch(clause& c, unsigned idx, clause_offset cls_off) {
@@ -1251,6 +1262,8 @@ namespace sat {
     //
     // -----------------------
     lbool solver::check(unsigned num_lits, literal const* lits) {
+        // the proof is complete up to the result of this check, also when the process is ended afterwards
+        on_scope_exit _flush([&]() { m_drat.flush(); });
         init_reason_unknown();
         pop_to_base_level();
         m_stats.m_units = init_trail_size();
@@ -1500,6 +1513,12 @@ namespace sat {
         int num_extra_solvers = m_config.m_num_threads - 1;
         int num_local_search  = static_cast<int>(m_config.m_local_search_threads);
         int num_ddfw      = m_ext ? 0 : static_cast<int>(m_config.m_ddfw_threads);
+        bool deterministic = m_config.m_par_deterministic && num_extra_solvers > 0;
+        if (deterministic && (num_local_search > 0 || num_ddfw > 0)) {
+            IF_VERBOSE(1, verbose_stream() << "(sat.parallel local search threads are disabled in deterministic mode)\n");
+            num_local_search = 0;
+            num_ddfw = 0;
+        }
         int num_threads = num_extra_solvers + 1 + num_local_search + num_ddfw;        
         vector<reslimit> lims(num_ddfw);
         scoped_ptr_vector<i_local_search> ls;
@@ -1529,7 +1548,9 @@ namespace sat {
 #define IS_MAIN_SOLVER(i)  (i == main_solver_offset)
 
         sat::parallel par(*this);
-        par.reserve(num_threads, 1 << 12);
+        par.reserve(num_threads, 1 << 16);
+        if (deterministic)
+            par.init_deterministic(num_extra_solvers + 1);
         par.init_solvers(*this, num_extra_solvers);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
@@ -1560,6 +1581,12 @@ namespace sat {
                 else {
                     r = check(num_lits, lits);
                 }
+                if (deterministic) {
+                    par.finish(IS_MAIN_SOLVER(i) ? *this : par.get_solver(i), r);
+                    if (i == par.winner())
+                        result = r;
+                    return;
+                }
                 bool first = false;
                 {
                     std::lock_guard<std::mutex> lock(mux);
@@ -1592,10 +1619,14 @@ namespace sat {
             catch (z3_error & err) {
                 error_code = err.error_code();
                 ex_kind = ERROR_EX;                
+                if (deterministic)
+                    par.finish(IS_MAIN_SOLVER(i) ? *this : par.get_solver(i), l_undef);
             }
             catch (z3_exception & ex) {
                 ex_msg = ex.what();
                 ex_kind = DEFAULT_EX;    
+                if (deterministic)
+                    par.finish(IS_MAIN_SOLVER(i) ? *this : par.get_solver(i), l_undef);
             }
         };
 
@@ -1611,6 +1642,10 @@ namespace sat {
         for (auto & th : threads) {
             th.join();
         }
+        if (deterministic) {
+            finished_id = par.winner();
+            canceled = !rlimit().inc();
+        }
         
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
@@ -1628,6 +1663,7 @@ namespace sat {
         if (!canceled) {
             rlimit().reset_cancel();
         }
+        par.collect_statistics(m_aux_stats);
         par.reset();
         set_par(nullptr, 0);
         ls.reset();
@@ -1647,6 +1683,7 @@ namespace sat {
       \brief import lemmas/units from parallel sat solvers.
      */
     void solver::exchange_par() {
+        if (m_par && m_par->is_deterministic()) return;
         if (m_par && at_base_lvl() && m_config.m_num_threads > 1) m_par->get_clauses(*this);
         if (m_par && at_base_lvl() && m_config.m_num_threads > 1) {
             // SASSERT(scope_lvl() == search_lvl());
@@ -1684,6 +1721,32 @@ namespace sat {
         m_par_limit_out = 0;
         m_par_id = id; 
         m_par_syncing_clauses = false;
+        m_par_next_sync = m_stats.m_conflicts + m_config.m_par_sync_conflicts;
+    }
+
+    bool solver::should_sync_par() const {
+        return m_par && m_par->is_deterministic() && m_stats.m_conflicts >= m_par_next_sync;
+    }
+
+    /*
+      \brief barrier of the deterministic parallel mode.
+      Export units and wait for the other solvers, then import their lemmas and units 
+      in a fixed order. Search is aborted once a solver has finished.
+     */
+    void solver::do_sync_par() {
+        m_par_next_sync = m_stats.m_conflicts + m_config.m_par_sync_conflicts;
+        pop(scope_lvl());
+        literal_vector out;
+        unsigned sz = init_trail_size();
+        for (unsigned i = m_par_limit_out; i < sz; ++i) {
+            literal lit = m_trail[i];
+            if (lit.var() < m_par_num_vars)
+                out.push_back(lit);
+        }
+        m_par_limit_out = sz;
+        if (!m_par->sync(*this, out))
+            throw abort_solver();
+        reinit_assumptions();
     }
 
     bool_var solver::next_var() {
@@ -1824,6 +1887,7 @@ namespace sat {
             else if (should_gc()) do_gc();
             else if (should_rephase()) do_rephase();
             else if (should_restart()) { if (!m_restart_enabled) return l_undef; do_restart(!m_config.m_restart_fast); }
+            else if (should_sync_par()) do_sync_par();
             else if (should_simplify()) do_simplify();
             else if (!decide()) is_sat = final_check();
         }
@@ -2053,6 +2117,7 @@ namespace sat {
         m_min_core_valid = false;
         m_min_core.reset();
         m_simplifier.init_search();
+        m_inprocess.init_search();
         m_mc.init_search(*this);
         if (m_ext)
             m_ext->init_search();
@@ -2094,19 +2159,26 @@ namespace sat {
         m_cleaner(m_config.m_force_cleanup);
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_scc();
+        if (m_inprocess.begin(inprocess::scc_t)) {
+            m_scc();
+            m_inprocess.end(num_vars());
+        }
         CASSERT("sat_simplify_bug", check_invariant());
 
         if (m_ext) {
             m_ext->pre_simplify();
         }
       
-        m_simplifier(false);
+        if (m_inprocess.begin(inprocess::simplify_t)) {
+            m_simplifier(false);
+            m_inprocess.end();
+        }
 
         CASSERT("sat_simplify_bug", check_invariant());
         CASSERT("sat_missed_prop", check_missed_propagation());
-        if (!m_learned.empty()) {
+        if (!m_learned.empty() && m_inprocess.begin(inprocess::simplify_learned_t)) {
             m_simplifier(true);
+            m_inprocess.end();
             CASSERT("sat_missed_prop", check_missed_propagation());
             CASSERT("sat_simplify_bug", check_invariant());
         }
@@ -2120,16 +2192,24 @@ namespace sat {
             m_ext->simplify();
         }
 
-        m_probing();
+        if (m_inprocess.begin(inprocess::probing_t)) {
+            m_probing();
+            m_inprocess.end();
+        }
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
+        if (m_inprocess.begin(inprocess::asymm_branch_t)) {
+            m_asymm_branch(false);
+            m_inprocess.end();
+        }
 
-        if (m_config.m_lookahead_simplify && !m_ext) {
+        if (m_config.m_lookahead_simplify && !m_ext && m_inprocess.begin(inprocess::lookahead_t)) {
             lookahead lh(*this);
             lh.simplify(true);
             lh.collect_statistics(m_aux_stats);
+            m_inprocess.end(m_clauses.size());
         }
+        IF_VERBOSE(3, m_inprocess.display(verbose_stream()));
 
         reinit_assumptions();
         if (inconsistent()) return;
@@ -2148,13 +2228,13 @@ namespace sat {
             m_par->to_solver(*this);
         }
 
-        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent()) {
+        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent() && m_inprocess.begin(inprocess::anf_t)) {
             anf_simplifier anf(*this);
             anf_simplifier::config cfg;
             cfg.m_enable_exlin = m_config.m_anf_exlin;
             anf();
             anf.collect_statistics(m_aux_stats);
-            // TBD: throttle anf_delay based on yield
+            m_inprocess.end(m_clauses.size());
         }        
 
         if (m_config.m_inprocess_out.is_non_empty_string()) {
@@ -2570,6 +2650,13 @@ namespace sat {
             case justification::CLAUSE: {
                 clause & c = get_clause(js);
                 unsigned i = 0;
+                if (c.is_learned() && m_config.m_gc_strategy == GC_TIER) {
+                    // clauses used in conflict analysis are kept and promoted when their glue drops.
+                    unsigned glue;
+                    c.mark_used();
+                    if (c.glue() > 2 && num_diff_levels_below(c.size(), c.begin(), c.glue() - 1, glue))
+                        update_glue(c, glue);
+                }
                 if (consequent != null_literal) {
                     SASSERT(c[0] == consequent || c[1] == consequent);
                     if (c[0] == consequent) {
@@ -2692,6 +2779,9 @@ namespace sat {
         clause * lemma = mk_clause_core(m_lemma.size(), m_lemma.data(), sat::status::redundant());
         if (lemma) {
             lemma->set_glue(glue);
+            // new lemmas survive the next gc in the tier strategy
+            if (m_config.m_gc_strategy == GC_TIER)
+                lemma->mark_used();
         }
         if (m_par && lemma) {
             m_par->share_clause(*this, *lemma);
@@ -2708,8 +2798,15 @@ namespace sat {
             (num_scopes <= m_config.m_backtrack_scopes || !allow_backtracking());
     }
 
+    /**
+       \brief chronological backtracking, Nadel and Ryvchin, SAT 2018.
+       The trail may contain literals assigned at levels below their position
+       after a chronological backtrack, so conflict analysis computes the conflict
+       level from the conflict, and lemmas are asserted at their backjump level
+       without undoing the levels above it.
+    */
     bool solver::allow_backtracking() const {
-        return m_conflicts_since_init > m_config.m_backtrack_init_conflicts;
+        return m_config.m_chrono && m_conflicts_since_init > m_config.m_backtrack_init_conflicts;
     }
 
     void solver::process_antecedent_for_unsat_core(literal antecedent) {
@@ -3644,6 +3741,8 @@ namespace sat {
         m_free_vars.shrink(j);
 
         for (bool_var w = m_justification.size(); w-- > v;) {
+            if (m_eliminated[w])
+                --m_num_eliminated;
             m_case_split_queue.del_var_eh(w);
             m_probing.reset_cache(literal(w, true));
             m_probing.reset_cache(literal(w, false));
@@ -3842,6 +3941,8 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_inprocess.collect_statistics(st);
+        m_vivify.collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         st.copy(m_aux_stats);
@@ -3853,6 +3954,8 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        m_inprocess.reset_statistics();
+        m_vivify.reset_statistics();
         m_aux_stats.reset();
     }
 
@@ -4822,6 +4925,11 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat tier promotions", m_tier_promotions);
+        st.update("sat tier demotions", m_tier_demotions);
+        st.update("sat tier core", m_tier_core);
+        st.update("sat tier tier2", m_tier_tier2);
+        st.update("sat tier local", m_tier_local);
     }
 
     void stats::reset() {
@@ -40,6 +40,8 @@ Revision History:
 #include "sat/sat_scc.h"
 #include "sat/sat_asymm_branch.h"
 #include "sat/sat_probing.h"
+#include "sat/sat_inprocess.h"
+#include "sat/sat_vivify.h"
 #include "sat/sat_mus.h"
 #include "sat/sat_drat.h"
 #include "sat/sat_parallel.h"
@@ -77,6 +79,11 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_tier_promotions;
+        unsigned m_tier_demotions;
+        unsigned m_tier_core;      // tier sizes after the last gc
+        unsigned m_tier_tier2;
+        unsigned m_tier_local;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -109,6 +116,8 @@ namespace sat {
         scc                     m_scc;
         asymm_branch            m_asymm_branch;
         probing                 m_probing;
+        inprocess               m_inprocess;
+        vivify                  m_vivify;
         bool                    m_is_probing { false };
         mus                     m_mus;           // MUS for minimal core extraction
         bool                    m_inconsistent;
@@ -129,6 +138,7 @@ namespace sat {
         bool_vector             m_mark;
         bool_vector             m_lit_mark;
         bool_vector             m_eliminated;
+        unsigned                m_num_eliminated { 0 };
         bool_vector             m_external;
         unsigned_vector         m_var_scope;
         unsigned_vector         m_touched;
@@ -201,6 +211,7 @@ namespace sat {
         unsigned                m_par_limit_out;
         unsigned                m_par_num_vars;
         bool                    m_par_syncing_clauses;
+        unsigned                m_par_next_sync { 0 };
 
         class lookahead*        m_cuber;
         class i_local_search*   m_local_search;
@@ -211,6 +222,7 @@ namespace sat {
 
         friend class integrity_checker;
         friend class cleaner;
+        friend class bva;
         friend class asymm_branch;
         friend class big;
         friend class drat;
@@ -218,6 +230,8 @@ namespace sat {
         friend class bcd;
         friend class mus;
         friend class probing;
+        friend class inprocess;
+        friend class vivify;
         friend class simplifier;
         friend class scc;
         friend class pb::solver;
@@ -373,6 +387,7 @@ namespace sat {
         void set_external(bool_var v) override;
         void set_non_external(bool_var v);
         bool was_eliminated(bool_var v) const { return m_eliminated[v]; }
+        unsigned num_eliminated() const { return m_num_eliminated; }
         void set_eliminated(bool_var v, bool f) override;
         bool was_eliminated(literal l) const { return was_eliminated(l.var()); }
         void set_phase(literal l) override;
@@ -596,6 +611,8 @@ namespace sat {
         bool reached_max_conflicts();
         void sort_watch_lits();
         void exchange_par();
+        bool should_sync_par() const;
+        void do_sync_par();
         lbool check_par(unsigned num_lits, literal const* lits);
         lbool do_local_search(unsigned num_lits, literal const* lits);
         lbool do_ddfw_search(unsigned num_lits, literal const* lits);
@@ -620,7 +637,20 @@ namespace sat {
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
+        void gc_tier();
         bool activate_frozen_clause(clause & c);
+
+        // tier of a learned clause of the given glue: 0 for core, 1 for tier2 and 2 for local clauses.
+        unsigned glue_tier(unsigned glue) const {
+            return glue <= m_config.m_gc_tier1_glue ? 0 : glue <= m_config.m_gc_tier2_glue ? 1 : 2;
+        }
+
+        void update_glue(clause & c, unsigned glue) {
+            if (glue_tier(glue) < glue_tier(c.glue()))
+                m_stats.m_tier_promotions++;
+            c.set_glue(glue);
+        }
+
         unsigned psm(clause const & c) const;
         bool can_delete(clause const & c) const;
         bool can_delete3(literal l1, literal l2, literal l3) const;
@@ -38,7 +38,7 @@ namespace sat {
 #define SAT_VB_LVL 10
 
 
-    typedef size_t clause_offset;
+    typedef unsigned clause_offset;
     typedef size_t ext_constraint_idx;
     typedef size_t ext_justification_idx;
 
@@ -0,0 +1,172 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.cpp
+
+Abstract:
+
+    Vivification of learned clauses.
+
+    Clauses are vivified at the base level. A strengthened clause is
+    implied by the remaining clauses, so it is reverse unit
+    propagation with respect to the clause it replaces and the
+    shrinking is logged to DRAT as an addition followed by a deletion.
+
+--*/
+
+#include "sat/sat_vivify.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    uint64_t vivify::ticks() const {
+        stats const& st = s.m_stats;
+        return static_cast<uint64_t>(st.m_propagate) + st.m_bin_propagate + st.m_ter_propagate;
+    }
+
+    bool vivify::is_candidate(clause const& c) const {
+        if (c.was_removed() || c.frozen() || c.on_reinit_stack() || c.size() <= 2 || c.glue() > s.m_config.m_vivify_glue)
+            return false;
+        for (literal l : c)
+            if (s.value(l) != l_undef)
+                return false;
+        return true;
+    }
+
+    void vivify::init_candidates() {
+        m_candidates.reset();
+        m_count.reset();
+        m_count.resize(2 * s.num_vars(), 0);
+        clause_vector const& learned = s.m_learned;
+        for (unsigned i = 0; i < learned.size(); ++i) {
+            clause const& c = *learned[i];
+            if (!is_candidate(c))
+                continue;
+            m_candidates.push_back(i);
+            for (literal l : c)
+                m_count[l.index()]++;
+            m_counter -= c.size();
+        }
+        // clauses that were not vivified before come first, then lex on (glue, size)
+        std::stable_sort(m_candidates.begin(), m_candidates.end(), [&](unsigned i, unsigned j) {
+            clause const& c1 = *learned[i], & c2 = *learned[j];
+            if (c1.vivified() != c2.vivified()) return !c1.vivified();
+            if (c1.glue() != c2.glue()) return c1.glue() < c2.glue();
+            return c1.size() < c2.size();
+        });
+    }
+
+    /**
+       \brief vivify c at the base level.
+       Return false if c was replaced by a unit or binary clause and deleted.
+    */
+    bool vivify::vivify_clause(clause& c) {
+        SASSERT(s.at_base_lvl());
+        ++m_num_clauses;
+        c.set_vivified(true);
+        unsigned sz = c.size();
+        s.detach_clause(c);
+        // literals that occur often are assigned first, they are the most likely to propagate.
+        std::sort(c.begin(), c.end(), [&](literal a, literal b) {
+            unsigned ca = m_count[a.index()], cb = m_count[b.index()];
+            return ca > cb || (ca == cb && a.index() < b.index());
+        });
+        uint64_t t0 = ticks();
+        unsigned j = 0;
+        s.push();
+        for (unsigned i = 0; i < sz && !s.inconsistent(); ++i) {
+            literal l = c[i];
+            lbool v = s.value(l);
+            if (v == l_false)
+                continue;
+            // literals are only permuted, the original clause is restored for DRAT.
+            std::swap(c[i], c[j++]);
+            if (v == l_true)
+                break;
+            s.assign_scoped(~l);
+            s.propagate_core(false); // c is detached, so propagate() would report a missed propagation
+        }
+        s.pop(1);
+        uint64_t t = ticks() - t0 + sz;
+        m_counter -= t;
+        m_ticks += t;
+        SASSERT(j > 0);
+        if (j == sz) {
+            s.attach_clause(c);
+            return true;
+        }
+        TRACE(sat_vivify, tout << "vivify " << c << " to " << j << " literals\n";);
+        ++m_num_strengthened;
+        m_num_lits += sz - j;
+        switch (j) {
+        case 1:
+            s.assign_unit(c[0]);
+            s.propagate_core(false);
+            s.del_clause(c);
+            return false;
+        case 2:
+            s.mk_bin_clause(c[0], c[1], true);
+            if (s.m_trail.size() > s.m_qhead)
+                s.propagate_core(false);
+            s.del_clause(c);
+            return false;
+        default:
+            s.shrink(c, sz, j);
+            c.set_glue(std::min(c.glue(), j));
+            s.attach_clause(c);
+            return true;
+        }
+    }
+
+    bool vivify::operator()() {
+        uint64_t search_ticks = ticks();
+        int64_t budget = static_cast<int64_t>((search_ticks - m_search_ticks) * s.m_config.m_vivify_effort / 1000);
+        if (budget <= 0 || s.m_learned.empty() || s.inconsistent())
+            return false;
+        s.pop(s.scope_lvl());
+        m_counter = budget;
+        ++m_num_rounds;
+        unsigned num_clauses = m_num_clauses, num_strengthened = m_num_strengthened, num_lits = m_num_lits;
+        init_candidates();
+        clause_vector& learned = s.m_learned;
+        for (unsigned idx : m_candidates) {
+            if (m_counter <= 0 || s.inconsistent())
+                break;
+            clause& c = *learned[idx];
+            // units found by earlier candidates may have assigned literals of c.
+            if (!is_candidate(c))
+                continue;
+            if (!vivify_clause(c))
+                learned[idx] = nullptr;
+        }
+        unsigned j = 0;
+        for (clause* c : learned)
+            if (c)
+                learned[j++] = c;
+        learned.shrink(j);
+        m_search_ticks = ticks();
+        IF_VERBOSE(2, verbose_stream() << "(sat-vivify :clauses " << m_num_clauses - num_clauses
+                   << " :strengthened " << m_num_strengthened - num_strengthened
+                   << " :elim-literals " << m_num_lits - num_lits
+                   << " :cost " << budget - m_counter << ")\n";);
+        return true;
+    }
+
+    void vivify::collect_statistics(statistics& st) const {
+        st.update("sat vivify rounds", m_num_rounds);
+        st.update("sat vivify clauses", m_num_clauses);
+        st.update("sat vivify strengthened", m_num_strengthened);
+        st.update("sat vivify elim literals", m_num_lits);
+        st.update("sat vivify ticks", static_cast<double>(m_ticks));
+    }
+
+    void vivify::reset_statistics() {
+        m_num_rounds = 0;
+        m_num_clauses = 0;
+        m_num_strengthened = 0;
+        m_num_lits = 0;
+        m_ticks = 0;
+    }
+}
@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.h
+
+Abstract:
+
+    Vivification of learned clauses.
+
+    A learned clause C = l1 | ... | ln is vivified by assigning
+    ~l1, ~l2, ... in turn and propagating, with C detached.
+    If the assignment of ~l1 .. ~li produces a conflict or
+    makes some later literal lj true, C is replaced by the
+    prefix l1 .. li (and lj). Literals that propagation makes
+    false are removed from C.
+
+    Vivification runs before garbage collection ranks the learned
+    clauses, so that strengthened clauses are ranked by their
+    reduced size and glue. It spends a fixed fraction of the
+    propagations used by search since the previous round.
+
+    Reference: Luo, Li, Xiao, Manyà, Lü. An Effective Learnt Clause
+    Minimization Approach for CDCL SAT Solvers. IJCAI 2017.
+
+--*/
+#pragma once
+
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+    class solver;
+
+    class vivify {
+        solver&         s;
+        unsigned_vector m_candidates;   // indices into the learned clauses
+        unsigned_vector m_count;        // occurrences of literals in candidates
+        int64_t         m_counter { 0 };
+        uint64_t        m_search_ticks { 0 };
+
+        unsigned m_num_rounds { 0 };
+        unsigned m_num_clauses { 0 };
+        unsigned m_num_strengthened { 0 };
+        unsigned m_num_lits { 0 };
+        uint64_t m_ticks { 0 };
+
+        uint64_t ticks() const;
+        bool is_candidate(clause const& c) const;
+        void init_candidates();
+        bool vivify_clause(clause& c);
+
+    public:
+        vivify(solver& s): s(s) {}
+
+        /**
+           \brief vivify learned clauses of small glue.
+           Return true if the solver was backtracked to the base level.
+        */
+        bool operator()();
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics();
+    };
+}
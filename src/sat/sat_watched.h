@@ -33,6 +33,10 @@ namespace sat {
        For binary clauses: we use a bit to store whether the binary clause was learned or not.
        
        Remark: there are no clause objects for binary clauses.
+
+       A watched element occupies 8 bytes: clauses are referenced by 32-bit offsets
+       into the clause arena. External constraint indices may use up to 62 bits;
+       the upper bits are stored next to the kind tag.
     */
 
     class extension;
@@ -43,7 +47,7 @@ namespace sat {
             BINARY = 0, CLAUSE, EXT_CONSTRAINT
         };
     private:
-        size_t   m_val1;
+        unsigned m_val1;
         unsigned m_val2; 
     public:
         watched(literal l, bool learned):
@@ -67,8 +71,9 @@ namespace sat {
         }
 
         explicit watched(ext_constraint_idx cnstr_idx):
-            m_val1(cnstr_idx),
-            m_val2(static_cast<unsigned>(EXT_CONSTRAINT)) {
+            m_val1(static_cast<unsigned>(cnstr_idx)),
+            m_val2(static_cast<unsigned>(EXT_CONSTRAINT) + (static_cast<unsigned>(static_cast<uint64_t>(cnstr_idx) >> 32) << 2)) {
+            SASSERT((static_cast<uint64_t>(cnstr_idx) >> 62) == 0);
             SASSERT(is_ext_constraint());
             SASSERT(get_ext_constraint_idx() == cnstr_idx);
         }
@@ -97,7 +102,10 @@ namespace sat {
         }
 
         bool is_ext_constraint() const { return get_kind() == EXT_CONSTRAINT; }
-        ext_constraint_idx get_ext_constraint_idx() const { SASSERT(is_ext_constraint()); return m_val1; }
+        ext_constraint_idx get_ext_constraint_idx() const { 
+            SASSERT(is_ext_constraint()); 
+            return static_cast<ext_constraint_idx>(static_cast<uint64_t>(m_val1) | (static_cast<uint64_t>(m_val2 >> 2) << 32)); 
+        }
         
         bool operator==(watched const & w) const { return m_val1 == w.m_val1 && m_val2 == w.m_val2; }
         bool operator!=(watched const & w) const { return !operator==(w); }
@@ -106,6 +114,7 @@ namespace sat {
     static_assert(0 <= watched::BINARY && watched::BINARY <= 2, "");
     static_assert(0 <= watched::CLAUSE && watched::CLAUSE <= 2, "");
     static_assert(0 <= watched::EXT_CONSTRAINT && watched::EXT_CONSTRAINT <= 2, "");
+    static_assert(sizeof(watched) == 8, "watched elements are expected to be 8 bytes");
 
     struct watched_lt {
         bool operator()(watched const & w1, watched const & w2) const {
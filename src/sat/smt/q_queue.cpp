@@ -50,6 +50,8 @@ namespace q {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        m_evaluator.compile(m_cost_function, m_cost_program);
+        m_evaluator.compile(m_new_gen_function, m_new_gen_program);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
     }
 
@@ -110,14 +112,14 @@ namespace q {
 
     float queue::get_cost(binding& f) {
         set_values(f, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
+        float r = m_evaluator(m_cost_program, m_vals.size(), m_vals.data());
         f.c->m_stat->update_max_cost(r);
         return r;
     }
 
     unsigned queue::get_new_gen(binding& f, float cost) {
         set_values(f, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = m_evaluator(m_new_gen_program, m_vals.size(), m_vals.data());
         return std::max(f.m_max_generation + 1, static_cast<unsigned>(r));
     }
 
@@ -56,6 +56,8 @@ static void display_statistics() {
 
 static void on_timeout() {
     display_statistics();
+    if (g_solver)
+        g_solver->get_drat().flush();
     _Exit(0);
 }
 
@@ -143,8 +145,8 @@ void verify_solution(char const * file_name) {
     p.set_bool("produce_models", true);
     reslimit limit;
     sat::solver solver(p, limit);
-    std::ifstream in(file_name);
-    if (in.bad() || in.fail()) {
+    dimacs::mapped_file in(file_name);
+    if (!in.ok()) {
         std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
         exit(ERR_OPEN_FILE);
     }
@@ -232,8 +234,8 @@ unsigned read_dimacs(char const * file_name) {
     g_solver = &solver;
 
     if (file_name) {
-        std::ifstream in(file_name);
-        if (in.bad() || in.fail()) {
+        dimacs::mapped_file in(file_name);
+        if (!in.ok()) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
             exit(ERR_OPEN_FILE);
         }
@@ -7,6 +7,7 @@ Copyright (c) 2020 Microsoft Corporation
 #include<fstream>
 #include "util/memory_manager.h"
 #include "util/statistics.h"
+#include "util/error_codes.h"
 #include "ast/proofs/proof_checker.h"
 #include "ast/reg_decl_plugins.h"
 #include "sat/dimacs.h"
@@ -67,7 +68,11 @@ public:
 unsigned read_drat(char const* drat_file) {
     ast_manager m;
     reg_decl_plugins(m);
-    std::ifstream ins(drat_file);
+    dimacs::mapped_file ins(drat_file);
+    if (!ins.ok()) {
+        std::cerr << "(error \"failed to open file '" << drat_file << "'\")" << std::endl;
+        exit(ERR_OPEN_FILE);
+    }
     dimacs::drat_parser drat(ins, std::cerr);
     
     std::function<int(char const* r)> read_theory = [&](char const* r) {
@@ -162,34 +162,22 @@ namespace smt {
     dyn_ack_manager::dyn_ack_manager(context & ctx, dyn_ack_params & p):
         m_context(ctx),
         m(ctx.get_manager()),
-        m_params(p) {
+        m_params(p),
+        m_app_pairs(m),
+        m_triple(m) {
     }
 
     dyn_ack_manager::~dyn_ack_manager() {
-        reset_app_pairs();
-        reset_expr_triples();
     }
 
-    void dyn_ack_manager::reset_app_pairs() {
-        for (app_pair& p : m_app_pairs) {
-            auto [a1, a2] = p;
-            m.dec_ref(a1);
-            m.dec_ref(a2);
-        }
-        m_app_pairs.reset();
-    }
-
-
     void dyn_ack_manager::init_search_eh() {
-        m_app_pair2num_occs.reset();
-        reset_app_pairs();
+        m_app_pairs.reset();
         m_to_instantiate.reset();
         m_qhead = 0;
         m_num_instances = 0;
         m_num_propagations_since_last_gc = 0;
 
-        m_triple.m_app2num_occs.reset();
-        reset_expr_triples();
+        m_triple.m_apps.reset();
         m_triple.m_to_instantiate.reset();
         m_triple.m_qhead = 0;
     }
@@ -207,26 +195,15 @@ namespace smt {
         if (m_instantiated.contains(p)) {
             return;
         }
-        unsigned num_occs = 0;
-        if (m_app_pair2num_occs.find(n1, n2, num_occs)) {
-            TRACE(dyn_ack, tout << "used_cg_eh:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
-            num_occs++;
-        }
-        else {
-            num_occs = 1;
-            m.inc_ref(n1);
-            m.inc_ref(n2);
-            m_app_pairs.push_back(p);
-        }
-        SASSERT(num_occs > 0);
-        m_app_pair2num_occs.insert(n1, n2, num_occs);
-#ifdef Z3DEBUG
-        unsigned num_occs2 = 0;
-        SASSERT(m_app_pair2num_occs.find(n1, n2, num_occs2) && num_occs == num_occs2);
-#endif
+        expr * args[2] = { n1, n2 };
+        unsigned idx = m_app_pairs.find(args);
+        if (idx == UINT_MAX)
+            idx = m_app_pairs.insert(args);
+        unsigned num_occs = ++m_app_pairs[idx].m_num_occs;
+        TRACE(dyn_ack, tout << "used_cg_eh:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
         if (num_occs == m_params.m_dack_threshold) {
             TRACE(dyn_ack, tout << "found candidate:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
-            m_to_instantiate.push_back(p);
+            m_to_instantiate.push_back(idx);
         }
     }
 
@@ -242,100 +219,63 @@ namespace smt {
         if (m_triple.m_instantiated.contains(tr)) {
             return;
         }
-        unsigned num_occs = 0;
-        if (m_triple.m_app2num_occs.find(n1, n2, r, num_occs)) {
-            TRACE(dyn_ack, tout << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\n"
-                  << mk_pp(r, m) << "\n" << "\nnum_occs: " << num_occs << "\n";);
-            num_occs++;
-        }
-        else {
-            num_occs = 1;
-            m.inc_ref(n1);
-            m.inc_ref(n2);
-            m.inc_ref(r);
-            m_triple.m_apps.push_back(tr);
-        }
-        SASSERT(num_occs > 0);
-        m_triple.m_app2num_occs.insert(n1, n2, r, num_occs);
-#ifdef Z3DEBUG
-        unsigned num_occs2 = 0;
-        SASSERT(m_triple.m_app2num_occs.find(n1, n2, r, num_occs2) && num_occs == num_occs2);
-#endif
+        expr * args[3] = { n1, n2, r };
+        unsigned idx = m_triple.m_apps.find(args);
+        if (idx == UINT_MAX)
+            idx = m_triple.m_apps.insert(args);
+        unsigned num_occs = ++m_triple.m_apps[idx].m_num_occs;
+        TRACE(dyn_ack, tout << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\n"
+              << mk_pp(r, m) << "\n" << "\nnum_occs: " << num_occs << "\n";);
         if (num_occs == m_params.m_dack_threshold) {
             TRACE(dyn_ack, tout << "found candidate:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) 
                   << "\n" << mk_pp(r, m) 
                   << "\nnum_occs: " << num_occs << "\n";);
-            m_triple.m_to_instantiate.push_back(tr);
+            m_triple.m_to_instantiate.push_back(idx);
         }
         
     }
 
-    struct app_pair_lt { 
-        typedef std::pair<app *, app *>          app_pair;
-        typedef obj_pair_map<app, app, unsigned> app_pair2num_occs;
-        app_pair2num_occs &  m_app_pair2num_occs;
-        
-        app_pair_lt(app_pair2num_occs & m):
-            m_app_pair2num_occs(m) {
-        }
-        
-        bool operator()(app_pair const & p1, app_pair const & p2) const {
-            auto [a1_1, a1_2] = p1;
-            auto [a2_1, a2_2] = p2;
-            unsigned n1 = 0;
-            unsigned n2 = 0;
-            m_app_pair2num_occs.find(a1_1, a1_2, n1);
-            m_app_pair2num_occs.find(a2_1, a2_2, n2);
-            SASSERT(n1 > 0);
-            SASSERT(n2 > 0);
-            return n1 > n2;
-        }
-    };
+    /**
+       \brief Decay the occurrence counters of the entries in table, and remove
+       the entries with at most one occurrence. Instantiated entries have no
+       occurrences. If more than max_entries entries remain, the entries with the
+       fewest occurrences are removed until half of max_entries remain.
+       Collect the entries to instantiate, in decreasing order of occurrences.
+    */
+    template<unsigned N>
+    void gc_table(ast_manager & m, dyn_ack_params const & p, dyn_ack_table<N> & table, unsigned max_entries, unsigned_vector & to_instantiate) {
+        auto decay = [&](typename dyn_ack_table<N>::entry & e) {
+            unsigned num_occs = static_cast<unsigned>(e.m_num_occs * p.m_dack_gc_inv_decay);
+            if (num_occs <= 1) {
+                TRACE(dyn_ack, tout << "erasing:\n"; for (expr * arg : e.m_args) tout << mk_pp(arg, m) << "\n";);
+                return false;
+            }
+            e.m_num_occs = num_occs;
+            return true;
+        };
+        table.filter(decay);
+        if (table.size() > max_entries) {
+            IF_VERBOSE(2, verbose_stream() << "(smt.dyn-ack :max-memory " << p.m_dack_max_memory << " :entries " << table.size() << ")\n");
+            table.shrink_to(max_entries / 2);
+        }
+        to_instantiate.reset();
+        for (unsigned i = 0; i < table.size(); ++i)
+            if (table[i].m_num_occs >= p.m_dack_threshold)
+                to_instantiate.push_back(i);
+        // the order on occurrences is not total.
+        // So, we should use stable_sort to avoid different behavior in different platforms.
+        std::stable_sort(to_instantiate.begin(), to_instantiate.end(), [&](unsigned i, unsigned j) {
+            return table[i].m_num_occs > table[j].m_num_occs;
+        });
+    }
+
+    template void gc_table<2>(ast_manager &, dyn_ack_params const &, dyn_ack_table<2> &, unsigned, unsigned_vector &);
+    template void gc_table<3>(ast_manager &, dyn_ack_params const &, dyn_ack_table<3> &, unsigned, unsigned_vector &);
 
     void dyn_ack_manager::gc() {
         TRACE(dyn_ack, tout << "dyn_ack GC\n";);
-        m_to_instantiate.reset();
+        gc_table(m, m_params, m_app_pairs, max_entries<2>(), m_to_instantiate);
         m_qhead = 0;
-        svector<app_pair>::iterator it  = m_app_pairs.begin();
-        svector<app_pair>::iterator end = m_app_pairs.end();
-        svector<app_pair>::iterator it2 = it;
-        for (; it != end; ++it) {
-            app_pair & p = *it;
-            auto [a1, a2] = p;
-            if (m_instantiated.contains(p)) {
-                TRACE(dyn_ack, tout << "1) erasing:\n" << mk_pp(a1, m) << "\n" << mk_pp(a2, m) << "\n";);
-                m.dec_ref(a1);
-                m.dec_ref(a2);
-                SASSERT(!m_app_pair2num_occs.contains(a1, a2));
-                continue;
-            }
-            unsigned num_occs = 0;
-            m_app_pair2num_occs.find(a1, a2, num_occs);
-            // The following invariant is not true. a1 and
-            // a2 may have been instantiated, and removed from
-            // m_app_pair2num_occs, but not from m_app_pairs.
-            //
-            // SASSERT(num_occs > 0);
-            num_occs = static_cast<unsigned>(num_occs * m_params.m_dack_gc_inv_decay);
-            if (num_occs <= 1) {
-                TRACE(dyn_ack, tout << "2) erasing:\n" << mk_pp(a1, m) << "\n" << mk_pp(a2, m) << "\n";);
-                m_app_pair2num_occs.erase(a1, a2);
-                m.dec_ref(a1);
-                m.dec_ref(a2);
-                continue;
-            }
-            *it2 = p;
-            ++it2;
-            SASSERT(num_occs > 0);
-            m_app_pair2num_occs.insert(a1, a2, num_occs);
-            if (num_occs >= m_params.m_dack_threshold)
-                m_to_instantiate.push_back(p);
-        }
-        m_app_pairs.set_end(it2);
-        app_pair_lt f(m_app_pair2num_occs);
-        // app_pair_lt is not a total order on pairs of expressions.
-        // So, we should use stable_sort to avoid different behavior in different platforms.
-        std::stable_sort(m_to_instantiate.begin(), m_to_instantiate.end(), f);
     }
 
     class dyn_ack_clause_del_eh : public clause_del_eh {
@@ -358,7 +298,10 @@ namespace smt {
             SASSERT(a1 && a2);
             m_instantiated.erase(p);
             m_clause2app_pair.erase(cls);
-            SASSERT(!m_app_pair2num_occs.contains(a1, a2));
+#ifdef Z3DEBUG
+            expr * args[2] = { a1, a2 };
+            SASSERT(m_app_pairs.get_num_occs(args) == 0);
+#endif
             return;
         }
         expr_triple tr(0,0,0);
@@ -367,7 +310,10 @@ namespace smt {
             SASSERT(a1 && a2 && a3);
             m_triple.m_instantiated.erase(tr);
             m_triple.m_clause2apps.erase(cls);
-            SASSERT(!m_triple.m_app2num_occs.contains(a1, a2, a3));
+#ifdef Z3DEBUG
+            expr * args[3] = { a1, a2, a3 };
+            SASSERT(m_triple.m_apps.get_num_occs(args) == 0);
+#endif
             return;
         }
     }
@@ -376,22 +322,24 @@ namespace smt {
         if (m_params.m_dack == dyn_ack_strategy::DACK_DISABLED)
             return;
         m_num_propagations_since_last_gc++;
-        if (m_num_propagations_since_last_gc > m_params.m_dack_gc) {
+        if (m_num_propagations_since_last_gc > m_params.m_dack_gc || m_app_pairs.size() > max_entries<2>()) {
             gc();
             m_num_propagations_since_last_gc = 0;
         }
+        if (m_triple.m_apps.size() > max_entries<3>())
+            gc_triples();
         unsigned max_instances  = static_cast<unsigned>(m_context.get_num_conflicts() * m_params.m_dack_factor);
         while (m_num_instances < max_instances && m_qhead < m_to_instantiate.size()) {
-            auto& [first, second] = m_to_instantiate[m_qhead];
+            auto const& e = m_app_pairs[m_to_instantiate[m_qhead]];
             m_qhead++;
             m_num_instances++;
-            instantiate(first, second);
+            instantiate(to_app(e.m_args[0]), to_app(e.m_args[1]));
         }
         while (m_num_instances < max_instances && m_triple.m_qhead < m_triple.m_to_instantiate.size()) {
-            auto& [first, second, third] = m_triple.m_to_instantiate[m_triple.m_qhead];
+            auto const& e = m_triple.m_apps[m_triple.m_to_instantiate[m_triple.m_qhead]];
             m_triple.m_qhead++;
             m_num_instances++;
-            instantiate(first, second, third);
+            instantiate(e.m_args[0], e.m_args[1], e.m_args[2]);
         }
     }
 
@@ -421,9 +369,11 @@ namespace smt {
                 lits.push_back(~mk_eq(arg1, arg2));
         }
         app_pair p(n1, n2);
-        SASSERT(m_app_pair2num_occs.contains(n1, n2));
-        m_app_pair2num_occs.erase(n1, n2);
-        // pair n1,n2 is still in m_app_pairs
+        expr * args[2] = { n1, n2 };
+        unsigned idx = m_app_pairs.find(args);
+        SASSERT(idx != UINT_MAX && m_app_pairs[idx].m_num_occs > 0);
+        // pair n1,n2 stays in m_app_pairs without occurrences until the next gc
+        m_app_pairs[idx].m_num_occs = 0;
         m_instantiated.insert(p);
         lits.push_back(mk_eq(n1, n2));
         clause_del_eh * del_eh = alloc(dyn_ack_clause_del_eh, *this);
@@ -451,15 +401,6 @@ namespace smt {
         m_triple.m_clause2apps.reset();
     }
 
-    void dyn_ack_manager::reset_expr_triples() {
-        for (auto &[a1,a2,a3] : m_triple.m_apps) {
-            m.dec_ref(a1);
-            m.dec_ref(a2);
-            m.dec_ref(a3);
-        }
-        m_triple.m_apps.reset();
-    }
-
     void dyn_ack_manager::instantiate(expr * n1, expr * n2, expr* r) {
         context& ctx = m_context;
         SASSERT(m_params.m_dack != dyn_ack_strategy::DACK_DISABLED);
@@ -471,9 +412,11 @@ namespace smt {
               << mk_pp(r,  m) << "\n";
               );
         expr_triple tr(n1, n2, r);
-        SASSERT(m_triple.m_app2num_occs.contains(n1, n2, r));
-        m_triple.m_app2num_occs.erase(n1, n2, r);
-        // pair n1,n2 is still in m_triple.m_apps
+        expr * args[3] = { n1, n2, r };
+        unsigned idx = m_triple.m_apps.find(args);
+        SASSERT(idx != UINT_MAX && m_triple.m_apps[idx].m_num_occs > 0);
+        // triple n1,n2,r stays in m_triple.m_apps without occurrences until the next gc
+        m_triple.m_apps[idx].m_num_occs = 0;
         m_triple.m_instantiated.insert(tr);
         literal_buffer lits;
         literal eq1 = mk_eq(n1, r);
@@ -503,84 +446,22 @@ namespace smt {
     }
 
 
-    struct expr_triple_lt { 
-        typedef triple<expr *, expr *,expr *>          expr_triple;
-        typedef obj_triple_map<expr, expr, expr, unsigned> expr_triple2num_occs;
-        expr_triple2num_occs &  m_expr_triple2num_occs;
-        
-        expr_triple_lt(expr_triple2num_occs & m):
-            m_expr_triple2num_occs(m) {
-        }
-        
-        bool operator()(expr_triple const & p1, expr_triple const & p2) const {
-            auto [a1_1, a1_2, a1_3] = p1;
-            auto [a2_1, a2_2, a2_3] = p2;
-            unsigned n1 = 0;
-            unsigned n2 = 0;
-            m_expr_triple2num_occs.find(a1_1, a1_2, a1_3, n1);
-            m_expr_triple2num_occs.find(a2_1, a2_2, a2_3, n2);
-            SASSERT(n1 > 0);
-            SASSERT(n2 > 0);
-            return n1 > n2;
-        }
-    };
-
     void dyn_ack_manager::gc_triples() {
         TRACE(dyn_ack, tout << "dyn_ack GC\n";);
-        m_triple.m_to_instantiate.reset();
+        gc_table(m, m_params, m_triple.m_apps, max_entries<3>(), m_triple.m_to_instantiate);
         m_triple.m_qhead = 0;
-        svector<expr_triple>::iterator it  = m_triple.m_apps.begin();
-        svector<expr_triple>::iterator end = m_triple.m_apps.end();
-        svector<expr_triple>::iterator it2 = it;
-        for (; it != end; ++it) {
-            expr_triple & p = *it;
-            auto [a1, a2, a3] = p;
-            if (m_triple.m_instantiated.contains(p)) {
-                TRACE(dyn_ack, tout << "1) erasing:\n" << mk_pp(a1, m) << "\n" << mk_pp(a2, m) << "\n";);
-                m.dec_ref(a1);
-                m.dec_ref(a2);
-                m.dec_ref(a3);
-                SASSERT(!m_triple.m_app2num_occs.contains(a1, a2, a3));
-                continue;
-            }
-            unsigned num_occs = 0;
-            m_triple.m_app2num_occs.find(a1, a2, a3, num_occs);
-            // The following invariant is not true. a1 and
-            // a2 may have been instantiated, and removed from
-            // m_triple.m_app2num_occs, but not from m_triple.m_apps.
-            //
-            // SASSERT(num_occs > 0);
-            num_occs = static_cast<unsigned>(num_occs * m_params.m_dack_gc_inv_decay);
-            if (num_occs <= 1) {
-                TRACE(dyn_ack, tout << "2) erasing:\n" << mk_pp(a1, m) << "\n" << mk_pp(a2, m) << "\n";);
-                m_triple.m_app2num_occs.erase(a1, a2, a3);
-                m.dec_ref(a1);
-                m.dec_ref(a2);
-                m.dec_ref(a3);
-                continue;
-            }
-            *it2 = p;
-            ++it2;
-            SASSERT(num_occs > 0);
-            m_triple.m_app2num_occs.insert(a1, a2, a3, num_occs);
-            if (num_occs >= m_params.m_dack_threshold)
-                m_triple.m_to_instantiate.push_back(p);
-        }
-        m_triple.m_apps.set_end(it2);
-        expr_triple_lt f(m_triple.m_app2num_occs);
-        // expr_triple_lt is not a total order
-        std::stable_sort(m_triple.m_to_instantiate.begin(), m_triple.m_to_instantiate.end(), f);
     }
 
-
-
 #ifdef Z3DEBUG
     bool dyn_ack_manager::check_invariant() const {
         for (auto const& kv : m_clause2app_pair) {
             app_pair const & p = kv.get_value();
             auto [a1, a2] = p;
             SASSERT(m_instantiated.contains(p));
-            SASSERT(!m_app_pair2num_occs.contains(a1, a2));
+#ifdef Z3DEBUG
+            expr * args[2] = { a1, a2 };
+            SASSERT(m_app_pairs.get_num_occs(args) == 0);
+#endif
         }
 
         return true;
@@ -23,31 +23,205 @@ Revision History:
 #include "util/obj_hashtable.h"
 #include "util/obj_pair_hashtable.h"
 #include "util/obj_triple_hashtable.h"
+#include "util/hash.h"
 #include "smt/smt_clause.h"
 
 namespace smt {
 
     class context;
 
+    /**
+       \brief Occurrence counters for tuples of N expressions.
+
+       The tuples and their counters are stored in a vector. They are found
+       through an open-addressing table of positions in the vector that is
+       keyed by the expression ids. Tuples are only removed by filter, which
+       compacts the vector and rebuilds the table. The table owns a reference
+       to the expressions of each tuple.
+    */
+    template<unsigned N>
+    class dyn_ack_table {
+    public:
+        struct entry {
+            expr *   m_args[N];
+            unsigned m_num_occs;
+        };
+
+        /**
+           \brief Upper bound on the bytes used per entry, taking the growth
+           of the vector and the load factor of the table into account.
+        */
+        static constexpr unsigned bytes_per_entry = 2 * sizeof(entry) + 4 * sizeof(unsigned);
+
+    private:
+        ast_manager &   m;
+        svector<entry>  m_entries;
+        unsigned_vector m_table;   // position + 1 of an entry, 0 for empty slots
+
+        static unsigned hash(expr * const * args) {
+            unsigned h = args[0]->get_id();
+            for (unsigned i = 1; i < N; ++i)
+                h = combine_hash(h, args[i]->get_id());
+            return h;
+        }
+
+        static bool eq(entry const & e, expr * const * args) {
+            for (unsigned i = 0; i < N; ++i)
+                if (e.m_args[i] != args[i])
+                    return false;
+            return true;
+        }
+
+        void insert_index(unsigned idx) {
+            unsigned mask = m_table.size() - 1;
+            unsigned i = hash(m_entries[idx].m_args) & mask;
+            while (m_table[i] != 0)
+                i = (i + 1) & mask;
+            m_table[i] = idx + 1;
+        }
+
+        void rebuild(unsigned capacity) {
+            m_table.reset();
+            m_table.resize(capacity, 0);
+            for (unsigned i = 0; i < m_entries.size(); ++i)
+                insert_index(i);
+        }
+
+    public:
+        dyn_ack_table(ast_manager & m): m(m) {}
+
+        ~dyn_ack_table() { reset(); }
+
+        unsigned size() const { return m_entries.size(); }
+
+        entry & operator[](unsigned idx) { return m_entries[idx]; }
+
+        entry const & operator[](unsigned idx) const { return m_entries[idx]; }
+
+        /**
+           \brief Return the position of the tuple args, or UINT_MAX if it is not in the table.
+        */
+        unsigned find(expr * const * args) const {
+            if (m_table.empty())
+                return UINT_MAX;
+            unsigned mask = m_table.size() - 1;
+            for (unsigned i = hash(args) & mask; m_table[i] != 0; i = (i + 1) & mask)
+                if (eq(m_entries[m_table[i] - 1], args))
+                    return m_table[i] - 1;
+            return UINT_MAX;
+        }
+
+        unsigned get_num_occs(expr * const * args) const {
+            unsigned idx = find(args);
+            return idx == UINT_MAX ? 0 : m_entries[idx].m_num_occs;
+        }
+
+        /**
+           \brief Insert the tuple args with no occurrences, and return its position.
+           \pre the tuple is not in the table.
+        */
+        unsigned insert(expr * const * args) {
+            SASSERT(find(args) == UINT_MAX);
+            entry e;
+            for (unsigned i = 0; i < N; ++i) {
+                e.m_args[i] = args[i];
+                m.inc_ref(args[i]);
+            }
+            e.m_num_occs = 0;
+            unsigned idx = m_entries.size();
+            m_entries.push_back(e);
+            if (2 * m_entries.size() > m_table.size())
+                rebuild(std::max(16u, 2 * m_table.size()));
+            else
+                insert_index(idx);
+            return idx;
+        }
+
+        /**
+           \brief Remove the entries for which keep returns false.
+           keep may update the counter of the entries it keeps.
+           Positions of entries are not preserved.
+        */
+        template<typename Keep>
+        void filter(Keep & keep) {
+            unsigned j = 0;
+            for (entry & e : m_entries) {
+                if (keep(e))
+                    m_entries[j++] = e;
+                else
+                    for (unsigned i = 0; i < N; ++i)
+                        m.dec_ref(e.m_args[i]);
+            }
+            m_entries.shrink(j);
+            unsigned capacity = 16;
+            while (capacity < 2 * j)
+                capacity *= 2;
+            rebuild(capacity);
+        }
+
+        /**
+           \brief Remove the entries with the fewest occurrences until n entries remain.
+           Ties at the cutoff are broken by position.
+        */
+        void shrink_to(unsigned n) {
+            if (m_entries.size() <= n)
+                return;
+            unsigned_vector occs;
+            for (entry const & e : m_entries)
+                occs.push_back(e.m_num_occs);
+            unsigned k = m_entries.size() - n;
+            std::nth_element(occs.begin(), occs.begin() + (k - 1), occs.end());
+            unsigned cutoff = occs[k - 1];
+            unsigned num_above = 0;
+            for (entry const & e : m_entries)
+                if (e.m_num_occs > cutoff)
+                    ++num_above;
+            SASSERT(num_above <= n);
+            unsigned num_at_cutoff = n - num_above;
+            auto keep = [&](entry const & e) { 
+                if (e.m_num_occs > cutoff)
+                    return true;
+                if (e.m_num_occs == cutoff && num_at_cutoff > 0) {
+                    --num_at_cutoff;
+                    return true;
+                }
+                return false;
+            };
+            filter(keep);
+            SASSERT(m_entries.size() == n);
+        }
+
+        void reset() {
+            for (entry & e : m_entries)
+                for (unsigned i = 0; i < N; ++i)
+                    m.dec_ref(e.m_args[i]);
+            m_entries.reset();
+            m_table.reset();
+        }
+    };
+
+    /**
+       \brief Garbage collect the entries of table, see dyn_ack.cpp.
+    */
+    template<unsigned N>
+    void gc_table(ast_manager & m, dyn_ack_params const & p, dyn_ack_table<N> & table, unsigned max_entries, unsigned_vector & to_instantiate);
+
     class dyn_ack_manager {
         typedef std::pair<app *, app *>           app_pair;
-        typedef obj_pair_map<app, app, unsigned>  app_pair2num_occs;
-        typedef svector<app_pair>                 app_pair_vector;
+        typedef dyn_ack_table<2>                  app_pair_table;
         typedef obj_pair_hashtable<app, app>      app_pair_set;
         typedef obj_map<clause, app_pair>         clause2app_pair;
 
         typedef triple<expr *, expr *,expr *>        expr_triple;
-        typedef obj_triple_map<expr, expr, expr, unsigned>  expr_triple2num_occs;
-        typedef svector<expr_triple>                 expr_triple_vector;
+        typedef dyn_ack_table<3>                     expr_triple_table;
         typedef obj_triple_hashtable<expr, expr, expr>      expr_triple_set;
         typedef obj_map<clause, expr_triple>         clause2expr_triple;
 
         context &                                  m_context;
         ast_manager &                              m;
         dyn_ack_params &                           m_params;
-        app_pair2num_occs                          m_app_pair2num_occs;
-        app_pair_vector                            m_app_pairs;
-        app_pair_vector                            m_to_instantiate;
+        app_pair_table                             m_app_pairs;
+        unsigned_vector                            m_to_instantiate;   // positions in m_app_pairs
         unsigned                                   m_qhead;
         unsigned                                   m_num_instances;
         unsigned                                   m_num_propagations_since_last_gc;
@@ -55,21 +229,30 @@ namespace smt {
         clause2app_pair                            m_clause2app_pair;
 
         struct _triple {
-            expr_triple2num_occs                   m_app2num_occs;
-            expr_triple_vector                     m_apps;
-            expr_triple_vector                     m_to_instantiate;
+            expr_triple_table                      m_apps;
+            unsigned_vector                        m_to_instantiate;   // positions in m_apps
             unsigned                               m_qhead;
             unsigned                               m_num_instances;
             unsigned                               m_num_propagations_since_last_gc;
             expr_triple_set                        m_instantiated;
             clause2expr_triple                     m_clause2apps;
+            _triple(ast_manager & m): m_apps(m) {}
         };
         _triple                                    m_triple;
         
-
+        /**
+           \brief Maximal number of entries in each of the tables of pairs and triples.
+        */
+        template<unsigned N>
+        unsigned max_entries() const {
+            if (m_params.m_dack_max_memory == 0)
+                return UINT_MAX;
+            // each table gets half of the memory budget
+            uint64_t budget = static_cast<uint64_t>(m_params.m_dack_max_memory) * 1024 * 1024 / 2;
+            return static_cast<unsigned>(std::min<uint64_t>(UINT_MAX, budget / dyn_ack_table<N>::bytes_per_entry));
+        }
 
         void gc();
-        void reset_app_pairs();
         friend class dyn_ack_clause_del_eh;
         void del_clause_eh(clause * cls);
         void instantiate(app * n1, app * n2);
@@ -78,7 +261,6 @@ namespace smt {
 
         void eq_eh(expr * n1, expr * n2, expr* r);
         void instantiate(expr * n1, expr * n2, expr* r);
-        void reset_expr_triples();
         void gc_triples();
         
     public:
@@ -141,6 +141,158 @@ namespace smt {
         }
     }
 
+    bool instance_cache::entry_eq_proc::operator()(entry const * e1, entry const * e2) const {
+        if (e1->m_q != e2->m_q || e1->m_num_args != e2->m_num_args)
+            return false;
+        for (unsigned i = 0; i < e1->m_num_args; ++i)
+            if (e1->m_args[i] != e2->m_args[i])
+                return false;
+        return true;
+    }
+
+    instance_cache::entry * instance_cache::mk_dummy(quantifier * q, unsigned num_args, enode * const * args) {
+        m_tmp.reserve(entry::get_obj_size(num_args) / sizeof(expr*) + 1);
+        entry * e = new (m_tmp.data()) entry();
+        e->m_q        = q;
+        e->m_num_args = num_args;
+        unsigned h    = q->get_id();
+        for (unsigned i = 0; i < num_args; ++i) {
+            e->m_args[i] = args[i]->get_root()->get_expr();
+            e->m_args[num_args + i] = args[i]->get_expr();
+            h = combine_hash(h, e->m_args[i]->get_id());
+        }
+        e->m_hash = h;
+        return e;
+    }
+
+    /**
+       \brief Return the bytes used by e and the expressions it references.
+    */
+    size_t instance_cache::get_size(entry const * e) {
+        size_t sz = entry::get_obj_size(e->m_num_args);
+        m_todo.reset();
+        m_todo.push_back(e->m_instance);
+        m_todo.push_back(e->m_result);
+        if (e->m_lemma)
+            m_todo.push_back(e->m_lemma);
+        m_todo.append(2 * e->m_num_args, e->m_args);
+        while (!m_todo.empty()) {
+            expr * n = m_todo.back();
+            m_todo.pop_back();
+            if (m_visited.is_marked(n))
+                continue;
+            m_visited.mark(n, true);
+            sz += get_node_size(n);
+            if (is_app(n))
+                m_todo.append(to_app(n)->get_num_args(), to_app(n)->get_args());
+            else if (is_quantifier(n))
+                m_todo.push_back(to_quantifier(n)->get_expr());
+        }
+        m_visited.reset();
+        return sz;
+    }
+
+    void instance_cache::set_max_memory(size_t max_memory) {
+        m_max_memory = max_memory;
+        while (m_lru && m_memory > m_max_memory) {
+            del_entry(m_lru->prev());
+            ++m_num_evictions;
+        }
+    }
+
+    bool instance_cache::find(quantifier * q, unsigned num_args, enode * const * args, std::function<enode*(expr*)> const & get_enode, instance & inst) {
+        entry * e = nullptr;
+        if (!m_table.find(mk_dummy(q, num_args, args), e)) {
+            ++m_num_misses;
+            return false;
+        }
+        for (unsigned i = 0; i < num_args; ++i) {
+            expr * b = e->m_args[num_args + i];
+            if (b == args[i]->get_expr())
+                continue;
+            enode * n = get_enode(b);
+            if (!n || n->get_root() != args[i]->get_root()) {
+                ++m_num_stale;
+                ++m_num_misses;
+                return false;
+            }
+        }
+        ++m_num_hits;
+        entry::push_to_front(m_lru, e);
+        inst.m_instance = e->m_instance;
+        inst.m_result   = e->m_result;
+        inst.m_lemma    = e->m_lemma;
+        inst.m_bindings = e->m_args + num_args;
+        return true;
+    }
+
+    void instance_cache::insert(quantifier * q, unsigned num_args, enode * const * args, expr * instance, expr * result, expr * lemma) {
+        if (entry::get_obj_size(num_args) > m_max_memory)
+            return;
+        entry * d = mk_dummy(q, num_args, args);
+        entry * old = nullptr;
+        if (m_table.find(d, old))
+            del_entry(old);   // the entry is stale
+        entry * e = new (memory::allocate(entry::get_obj_size(num_args))) entry();
+        e->init(e);
+        e->m_q          = q;
+        e->m_instance   = instance;
+        e->m_result     = result;
+        e->m_lemma      = lemma;
+        e->m_hash       = d->m_hash;
+        e->m_num_args   = num_args;
+        for (unsigned i = 0; i < 2 * num_args; ++i)
+            e->m_args[i] = d->m_args[i];
+        e->m_size       = get_size(e);
+        if (e->m_size > m_max_memory) {
+            e->~entry();
+            memory::deallocate(e);
+            return;
+        }
+        while (m_lru && m_memory + e->m_size > m_max_memory) {
+            del_entry(m_lru->prev());
+            ++m_num_evictions;
+        }
+        m.inc_ref(q);
+        m.inc_ref(instance);
+        m.inc_ref(result);
+        m.inc_ref(lemma);
+        for (unsigned i = 0; i < 2 * num_args; ++i)
+            m.inc_ref(e->m_args[i]);
+        m_table.insert(e);
+        entry::push_to_front(m_lru, e);
+        m_memory += e->m_size;
+    }
+
+    void instance_cache::del_entry(entry * e) {
+        m_table.erase(e);
+        entry::remove_from(m_lru, e);
+        m_memory -= e->m_size;
+        m.dec_ref(e->m_q);
+        m.dec_ref(e->m_instance);
+        m.dec_ref(e->m_result);
+        m.dec_ref(e->m_lemma);
+        for (unsigned i = 0; i < 2 * e->m_num_args; ++i)
+            m.dec_ref(e->m_args[i]);
+        e->~entry();
+        memory::deallocate(e);
+    }
+
+    void instance_cache::reset() {
+        while (m_lru)
+            del_entry(m_lru);
+        SASSERT(m_table.empty());
+        SASSERT(m_memory == 0);
+    }
+
+    void instance_cache::collect_statistics(::statistics & st) const {
+        st.update("quant instance cache hits", m_num_hits);
+        st.update("quant instance cache misses", m_num_misses);
+        st.update("quant instance cache stale", m_num_stale);
+        st.update("quant instance cache evictions", m_num_evictions);
+        st.update("quant instance cache size", m_table.size());
+    }
+
 #ifdef Z3DEBUG
     /**
        \brief Slow function for checking if there is a fingerprint congruent to (data args[0] ... args[num_args-1])
@@ -20,6 +20,9 @@ Revision History:
 
 #include "smt/smt_enode.h"
 #include "util/util.h"
+#include "util/dlist.h"
+#include "util/statistics.h"
+#include <functional>
 
 namespace smt {
 
@@ -76,6 +79,89 @@ namespace smt {
         bool slow_contains(void const * data, unsigned data_hash, unsigned num_args, enode * const * args) const;
 #endif
     };
+
+    /**
+       \brief Cache of quantifier instances keyed by the quantifier and the
+       congruence roots of the bindings.
+
+       Unlike fingerprint_set, which records the instances asserted in the
+       current scope and must forget them on pop, an entry stores the
+       instance of the body of the quantifier, its simplified form and the
+       lemma that is asserted for it. The lemma is valid in every scope, so
+       the cache is kept across push and pop. Instances that are re-derived
+       after backtracking then skip substitution, rewriting and building
+       the lemma.
+
+       An entry also records the bindings it was created for. It is only
+       used while these bindings are still congruent to the bindings of
+       the lookup: merges of the roots may have been undone by pop.
+
+       The budget covers the entries and the expressions they keep alive,
+       shared subterms are counted once per entry. Entries are evicted in
+       least recently used order when the budget is exceeded.
+    */
+    class instance_cache {
+        struct entry : public dll_base<entry> {
+            quantifier * m_q;
+            expr *       m_instance;
+            expr *       m_result;
+            expr *       m_lemma;
+            size_t       m_size;
+            unsigned     m_hash;
+            unsigned     m_num_args;
+            expr *       m_args[0];    // the roots of the bindings, followed by the bindings
+            static size_t get_obj_size(unsigned n) { return sizeof(entry) + 2 * n * sizeof(expr*); }
+        };
+        struct entry_hash_proc {
+            unsigned operator()(entry const * e) const { return e->m_hash; }
+        };
+        struct entry_eq_proc { bool operator()(entry const * e1, entry const * e2) const; };
+        typedef ptr_hashtable<entry, entry_hash_proc, entry_eq_proc> table;
+
+        ast_manager &   m;
+        table           m_table;
+        entry *         m_lru = nullptr;    // most recently used entry first
+        size_t          m_memory = 0;
+        size_t          m_max_memory = 0;
+        ptr_vector<expr> m_tmp;
+        ptr_vector<expr> m_todo;
+        expr_mark       m_visited;
+        unsigned        m_num_hits = 0;
+        unsigned        m_num_misses = 0;
+        unsigned        m_num_stale = 0;
+        unsigned        m_num_evictions = 0;
+
+        entry * mk_dummy(quantifier * q, unsigned num_args, enode * const * args);
+        size_t get_size(entry const * e);
+        void del_entry(entry * e);
+
+    public:
+        struct instance {
+            expr *         m_instance = nullptr;
+            expr *         m_result = nullptr;
+            expr *         m_lemma = nullptr;
+            expr * const * m_bindings = nullptr;
+        };
+
+        instance_cache(ast_manager & m): m(m) {}
+        ~instance_cache() { reset(); }
+        void set_max_memory(size_t max_memory);
+        bool enabled() const { return m_max_memory > 0; }
+        /**
+           \brief Retrieve the instance of q for the roots of args.
+           get_enode returns the enode of an expression, or nullptr if it is not internalized.
+           The expressions of inst remain valid until the next insertion.
+        */
+        bool find(quantifier * q, unsigned num_args, enode * const * args, std::function<enode*(expr*)> const & get_enode, instance & inst);
+        /**
+           \brief Insert the instance of q for args, lemma is nullptr if result is true.
+        */
+        void insert(quantifier * q, unsigned num_args, enode * const * args, expr * instance, expr * result, expr * lemma);
+        unsigned size() const { return m_table.size(); }
+        size_t memory() const { return m_memory; }
+        void reset();
+        void collect_statistics(::statistics & st) const;
+    };
 }
 
 
@@ -1860,6 +1860,7 @@ namespace {
         enode *             m_n2;
         enode *             m_app;
         const bind *        m_b;
+        mam_stats           m_stats;
 
         // equalities used for pattern match. The first element of the tuple gives the argument (or null) of some term that was matched against some higher level
         // structure of the trigger, the second element gives the term that argument is replaced with in order to match the trigger. Used for logging purposes only.
@@ -1869,6 +1870,7 @@ namespace {
         unsigned_vector     m_min_top_generation, m_max_top_generation;
 
         pool<enode_vector>  m_pool;
+        enode_vector        m_batch;      // candidates of the code tree being executed
 
         enode_vector * mk_enode_vector() {
             enode_vector * r = m_pool.mk();
@@ -2010,38 +2012,37 @@ namespace {
                 m_backtrack_stack.resize(t->get_num_choices());
         }
 
+        /**
+           \brief Match the candidates of t in one batch.
+           Candidates that cannot match the root instruction of t (duplicates,
+           enodes that are not congruence roots, applications of a different arity)
+           are dropped before any of them is executed.
+        */
         bool execute(code_tree * t) {
             TRACE(trigger_bug, tout << "execute for code tree:\n"; t->display(tout););
             init(t);
-#define CLEANUP  for (enode* app : t->get_candidates()) if (app->is_marked()) app->unset_mark();
-            if (t->filter_candidates()) {
-                for (enode* app : t->get_candidates()) {
-                    TRACE(trigger_bug, tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
-                    if (!app->is_marked() && app->is_cgr()) {
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app)) {
-                            CLEANUP;
-                            return false;
-                        }
-                        app->set_mark();
-                    }
+            unsigned num_args = t->expected_num_args();
+            m_batch.reset();
+            for (enode* app : t->get_candidates()) {
+                TRACE(trigger_bug, tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
+                if (!app->is_marked() && app->is_cgr() && app->get_num_args() == num_args) {
+                    app->set_mark();
+                    m_batch.push_back(app);
                 }
-                CLEANUP;
-                
             }
-            else {
-                for (enode* app : t->get_candidates()) {
-                    TRACE(trigger_bug, tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
-                    if (app->is_cgr()) {
-                        TRACE(trigger_bug, tout << "is_cgr\n";);
-                        // scoped_suspend_rlimit susp(m.limit(), false);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
-                            return false;
-                    }
-                }
+            for (enode* app : m_batch)
+                app->unset_mark();
+            m_stats.m_num_candidates += t->get_candidates().size();
+            m_stats.m_num_filtered += t->get_candidates().size() - m_batch.size();
+            for (enode* app : m_batch) {
+                if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                    return false;
             }
             return true;
         }
 
+        mam_stats const & get_stats() const { return m_stats; }
+
         // init(t) must be invoked before execute_core
         bool execute_core(code_tree * t, enode * n);
 
@@ -2279,6 +2280,33 @@ namespace {
     }
 #endif
 
+    /**
+       With computed goto every instruction ends with its own indirect jump
+       to the next instruction (threaded code) instead of returning to the
+       switch in main_loop. The code tree is still walked instruction by
+       instruction, but each jump site is predicted separately, which suits
+       the short instruction sequences the compiler produces for patterns.
+       The switch is kept for the other compilers and for _PROFILE_MAM.
+    */
+#if defined(__GNUC__) && !defined(_PROFILE_MAM)
+#define MAM_THREADED_CODE
+#endif
+
+#ifdef MAM_THREADED_CODE
+#define MAM_OP(OP) case OP: op_##OP
+#define MAM_NEXT()                                                      \
+        {                                                               \
+            if (!m_pc)                                                  \
+                goto backtrack;                                         \
+            TRACE(mam_int, display_pc_info(tout););                     \
+            m_stats.m_num_instructions++;                               \
+            goto *s_dispatch[m_pc->m_opcode];                           \
+        } ((void)0)
+#else
+#define MAM_OP(OP) case OP
+#define MAM_NEXT() goto main_loop
+#endif
+
     bool interpreter::execute_core(code_tree * t, enode * n) {
         TRACE(trigger_bug, tout << "interpreter::execute_core\n"; t->display(tout); tout << "\nenode\n" << mk_ismt2_pp(n->get_expr(), m) << "\n";);
         unsigned since_last_check = 0;
@@ -2311,36 +2339,51 @@ namespace {
         m_pc             = t->get_root();
         m_registers[0]   = n;
         m_top            = 0;
-
-
+        m_stats.m_num_executions++;
+
+#ifdef MAM_THREADED_CODE
+        // indexed by opcode
+        static void * const s_dispatch[] = {
+            &&op_INIT1,  &&op_INIT2,  &&op_INIT3,  &&op_INIT4,  &&op_INIT5,  &&op_INIT6,  &&op_INITN,
+            &&op_BIND1,  &&op_BIND2,  &&op_BIND3,  &&op_BIND4,  &&op_BIND5,  &&op_BIND6,  &&op_BINDN,
+            &&op_YIELD1, &&op_YIELD2, &&op_YIELD3, &&op_YIELD4, &&op_YIELD5, &&op_YIELD6, &&op_YIELDN,
+            &&op_COMPARE, &&op_CHECK, &&op_FILTER, &&op_CFILTER, &&op_PFILTER, &&op_CHOOSE, &&op_NOOP, &&op_CONTINUE,
+            &&op_GET_ENODE,
+            &&op_GET_CGR1, &&op_GET_CGR2, &&op_GET_CGR3, &&op_GET_CGR4, &&op_GET_CGR5, &&op_GET_CGR6, &&op_GET_CGRN,
+            &&op_IS_CGR
+        };
+        static_assert(sizeof(s_dispatch) / sizeof(s_dispatch[0]) == IS_CGR + 1, "dispatch table does not match opcodes");
+        MAM_NEXT();
+#else
     main_loop:
 
         if (!m_pc)
             goto backtrack;
         TRACE(mam_int, display_pc_info(tout););
-        
+        m_stats.m_num_instructions++;
 #ifdef _PROFILE_MAM
         const_cast<instruction*>(m_pc)->m_counter++;
+#endif
 #endif
         switch (m_pc->m_opcode) {
-        case INIT1:
+        MAM_OP(INIT1):
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 1)
                 goto backtrack;
             m_registers[1] = m_app->get_arg(0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT2:
+        MAM_OP(INIT2):
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 2)
                 goto backtrack;
             m_registers[1] = m_app->get_arg(0);
             m_registers[2] = m_app->get_arg(1);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT3:
+        MAM_OP(INIT3):
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 3)
                 goto backtrack;
@@ -2348,9 +2391,9 @@ namespace {
             m_registers[2] = m_app->get_arg(1);
             m_registers[3] = m_app->get_arg(2);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT4:
+        MAM_OP(INIT4):
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 4)
                 goto backtrack;
@@ -2359,9 +2402,9 @@ namespace {
             m_registers[3] = m_app->get_arg(2);
             m_registers[4] = m_app->get_arg(3);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT5:
+        MAM_OP(INIT5):
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 5)
                 goto backtrack;
@@ -2371,9 +2414,9 @@ namespace {
             m_registers[4] = m_app->get_arg(3);
             m_registers[5] = m_app->get_arg(4);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT6:
+        MAM_OP(INIT6):
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 6)
                 goto backtrack;
@@ -2384,9 +2427,9 @@ namespace {
             m_registers[5] = m_app->get_arg(4);
             m_registers[6] = m_app->get_arg(5);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INITN:
+        MAM_OP(INITN):
             m_app      = m_registers[0];
             m_num_args = m_app->get_num_args();
             if (m_num_args != static_cast<const initn *>(m_pc)->m_num_args)
@@ -2394,9 +2437,9 @@ namespace {
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[i+1] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case COMPARE:
+        MAM_OP(COMPARE):
             m_n1 = m_registers[static_cast<const compare *>(m_pc)->m_reg1];
             m_n2 = m_registers[static_cast<const compare *>(m_pc)->m_reg2];
             SASSERT(m_n1 != 0);
@@ -2411,9 +2454,9 @@ namespace {
             }
 
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case CHECK:
+        MAM_OP(CHECK):
             m_n1 = m_registers[static_cast<const check *>(m_pc)->m_reg];
             m_n2 = static_cast<const check *>(m_pc)->m_enode;
             SASSERT(m_n1 != 0);
@@ -2430,40 +2473,40 @@ namespace {
             }
 
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
             /* CFILTER AND FILTER are handled differently by the compiler
                The compiler will never merge two CFILTERs with different m_lbl_set fields.
                Essentially, CFILTER is used to combine CHECK statements, and FILTER for BIND
             */
-        case CFILTER:
-        case FILTER:
+        MAM_OP(CFILTER):
+        MAM_OP(FILTER):
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
             if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_lbls()))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case PFILTER:
+        MAM_OP(PFILTER):
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
             if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_plbls()))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case CHOOSE:
+        MAM_OP(CHOOSE):
             m_backtrack_stack[m_top].m_instr                = m_pc;
             m_backtrack_stack[m_top].m_old_max_generation   = m_max_generation;
             m_backtrack_stack[m_top].m_old_used_enodes_size = m_used_enodes.size();
             m_top++;
             m_pc = m_pc->m_next;
-            goto main_loop;
-        case NOOP:
+            MAM_NEXT();
+        MAM_OP(NOOP):
             SASSERT(static_cast<const choose *>(m_pc)->m_alt == 0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND1:
+        MAM_OP(BIND1):
 #define BIND_COMMON()                                                                                                   \
                  m_n1   = m_registers[static_cast<const bind *>(m_pc)->m_ireg];                                         \
                  SASSERT(m_n1 != 0);                                                                                    \
@@ -2483,33 +2526,33 @@ namespace {
             BIND_COMMON();
             m_registers[m_oreg] = m_app->get_arg(0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND2:
+        MAM_OP(BIND2):
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND3:
+        MAM_OP(BIND3):
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND4:
+        MAM_OP(BIND4):
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND5:
+        MAM_OP(BIND5):
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
@@ -2517,9 +2560,9 @@ namespace {
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND6:
+        MAM_OP(BIND6):
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
@@ -2528,19 +2571,20 @@ namespace {
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_registers[m_oreg+5] = m_app->get_arg(5);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BINDN:
+        MAM_OP(BINDN):
             BIND_COMMON();
             m_num_args = static_cast<const bind *>(m_pc)->m_num_args;
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case YIELD1:
+        MAM_OP(YIELD1):
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                   \
+            m_stats.m_num_matches++;                                    \
             m_max_generation = std::max(m_max_generation, m_context.get_max_generation(NUM, m_bindings.begin())); \
             if (m_context.get_cancel_flag()) {                          \
                 return false;                                           \
@@ -2553,20 +2597,20 @@ namespace {
             ON_MATCH(1);
             goto backtrack;
 
-        case YIELD2:
+        MAM_OP(YIELD2):
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
             ON_MATCH(2);
             goto backtrack;
 
-        case YIELD3:
+        MAM_OP(YIELD3):
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
             ON_MATCH(3);
             goto backtrack;
 
-        case YIELD4:
+        MAM_OP(YIELD4):
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
@@ -2574,7 +2618,7 @@ namespace {
             ON_MATCH(4);
             goto backtrack;
 
-        case YIELD5:
+        MAM_OP(YIELD5):
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[4]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
@@ -2583,7 +2627,7 @@ namespace {
             ON_MATCH(5);
             goto backtrack;
 
-        case YIELD6:
+        MAM_OP(YIELD6):
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[5]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[4]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
@@ -2593,19 +2637,19 @@ namespace {
             ON_MATCH(6);
             goto backtrack;
 
-        case YIELDN:
+        MAM_OP(YIELDN):
             m_num_args = static_cast<const yield *>(m_pc)->m_num_bindings;
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_bindings[i] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[m_num_args - i - 1]];
             ON_MATCH(m_num_args);
             goto backtrack;
 
-        case GET_ENODE:
+        MAM_OP(GET_ENODE):
             m_registers[static_cast<const get_enode_instr *>(m_pc)->m_oreg] = static_cast<const get_enode_instr *>(m_pc)->m_enode;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case GET_CGR1:
+        MAM_OP(GET_CGR1):
 #define GET_CGR_COMMON()                                                                                                                                                \
             m_n1 = m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
@@ -2618,7 +2662,7 @@ namespace {
             }                                                                                                                                                           \
             m_registers[static_cast<const get_cgr *>(m_pc)->m_oreg] = m_n1;                                                                                             \
             m_pc = m_pc->m_next;                                                                                                                                        \
-            goto main_loop;
+            MAM_NEXT();
 
 #define SET_VAR(IDX)                                                    \
             m_args[IDX] = m_registers[static_cast<const get_cgr *>(m_pc)->m_iregs[IDX]]; \
@@ -2632,25 +2676,25 @@ namespace {
             SET_VAR(0);
             GET_CGR_COMMON();
 
-        case GET_CGR2:
+        MAM_OP(GET_CGR2):
             SET_VAR(0);
             SET_VAR(1);
             GET_CGR_COMMON();
 
-        case GET_CGR3:
+        MAM_OP(GET_CGR3):
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
             GET_CGR_COMMON();
 
-        case GET_CGR4:
+        MAM_OP(GET_CGR4):
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
             SET_VAR(3);
             GET_CGR_COMMON();
 
-        case GET_CGR5:
+        MAM_OP(GET_CGR5):
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
@@ -2658,7 +2702,7 @@ namespace {
             SET_VAR(4);
             GET_CGR_COMMON();
 
-        case GET_CGR6:
+        MAM_OP(GET_CGR6):
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
@@ -2667,20 +2711,20 @@ namespace {
             SET_VAR(5);
             GET_CGR_COMMON();
 
-        case GET_CGRN:
+        MAM_OP(GET_CGRN):
             m_num_args = static_cast<const get_cgr *>(m_pc)->m_num_args;
             m_args.reserve(m_num_args, 0);
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_args[i] = m_registers[static_cast<const get_cgr *>(m_pc)->m_iregs[i]];
             GET_CGR_COMMON();
 
-        case IS_CGR:
+        MAM_OP(IS_CGR):
             if (!exec_is_cgr(static_cast<const is_cgr *>(m_pc)))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case CONTINUE:
+        MAM_OP(CONTINUE):
             m_num_args = static_cast<const cont *>(m_pc)->m_num_args;
             m_oreg     = static_cast<const cont *>(m_pc)->m_oreg;
             m_app = init_continue(static_cast<const cont *>(m_pc), m_num_args);
@@ -2691,7 +2735,7 @@ namespace {
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         }
 
@@ -2740,7 +2784,7 @@ namespace {
             TRACE(mam_int, tout << "alt: " << m_pc << "\n";);
             SASSERT(m_pc != 0);
             m_top--;
-            goto main_loop;
+            MAM_NEXT();
         case BIND1:
 #define BBIND_COMMON() m_b   = static_cast<const bind*>(bp.m_instr);                                                            \
                        m_n1  = m_registers[m_b->m_ireg];                                                                        \
@@ -2756,14 +2800,14 @@ namespace {
             BBIND_COMMON();
             m_registers[m_oreg] = m_app->get_arg(0);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND2:
             BBIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_pc = m_b->m_next;
-                goto main_loop;
+                MAM_NEXT();
 
         case BIND3:
             BBIND_COMMON();
@@ -2771,7 +2815,7 @@ namespace {
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND4:
             BBIND_COMMON();
@@ -2780,7 +2824,7 @@ namespace {
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND5:
             BBIND_COMMON();
@@ -2790,7 +2834,7 @@ namespace {
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND6:
             BBIND_COMMON();
@@ -2801,7 +2845,7 @@ namespace {
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_registers[m_oreg+5] = m_app->get_arg(5);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BINDN:
             BBIND_COMMON();
@@ -2809,7 +2853,7 @@ namespace {
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case CONTINUE:
             ++bp.m_it;
@@ -2836,7 +2880,7 @@ namespace {
                     for (unsigned i = 0; i < m_num_args; ++i)
                         m_registers[m_oreg+i] = m_app->get_arg(i);
                     m_pc = c->m_next;
-                    goto main_loop;
+                    MAM_NEXT();
                 }
             }
             // continue failed
@@ -2851,6 +2895,9 @@ namespace {
         return false;
     } // end of execute_core
 
+#undef MAM_OP
+#undef MAM_NEXT
+
 #if 0
     void display_trees(std::ostream & out, const ptr_vector<code_tree> & trees) {
         unsigned lbl = 0;
@@ -3901,8 +3948,15 @@ namespace {
             }
         }
 
+        struct scoped_profile {
+            qi_profiler * m_profiler;
+            scoped_profile(qi_profiler * p): m_profiler(p) { if (p) p->start_matching(); }
+            ~scoped_profile() { if (m_profiler) m_profiler->stop_matching(); }
+        };
+
         void match() override {
             TRACE(trigger_bug, tout << "match\n"; display(tout););
+            scoped_profile _profile(m_context.get_qi_profiler());
             for (code_tree* t : m_to_match) {
                 SASSERT(t->has_candidates());
                 if (!m_interpreter.execute(t))
@@ -3917,6 +3971,7 @@ namespace {
         }
 
         void rematch(bool use_irrelevant) override {
+            scoped_profile _profile(m_context.get_qi_profiler());
             ptr_vector<code_tree>::iterator it  = m_trees.begin_code_trees();
             ptr_vector<code_tree>::iterator end = m_trees.end_code_trees();
             unsigned lbl = 0;
@@ -3967,6 +4022,10 @@ namespace {
             return !m_shared_enodes.empty() && m_shared_enodes.contains(n);
         }
 
+        void add_statistics(mam_stats & st) const override {
+            st.add(m_interpreter.get_stats());
+        }
+
         // This method is invoked when n becomes relevant.
         // If lazy == true, then n is not added to the list of candidate enodes for matching. That is, the method just updates the lbls.
         void relevant_eh(enode * n, bool lazy) override {
@@ -4035,6 +4094,26 @@ namespace {
 }
 
 namespace smt {
+    void mam_stats::add(mam_stats const & st) {
+        m_num_candidates   += st.m_num_candidates;
+        m_num_filtered     += st.m_num_filtered;
+        m_num_executions   += st.m_num_executions;
+        m_num_matches      += st.m_num_matches;
+        m_num_instructions += st.m_num_instructions;
+    }
+
+    void mam_stats::collect_statistics(::statistics & st) const {
+        if (m_num_executions == 0)
+            return;
+        st.update("mam candidates", m_num_candidates);
+        st.update("mam filtered candidates", m_num_filtered);
+        st.update("mam executions", m_num_executions);
+        st.update("mam matches", m_num_matches);
+        st.update("mam instructions", static_cast<double>(m_num_instructions));
+        if (m_num_matches > 0)
+            st.update("mam instructions per match", static_cast<double>(m_num_instructions) / m_num_matches);
+    }
+
     mam * mk_mam(context & ctx) {
         return alloc(mam_impl, ctx, true);
     }
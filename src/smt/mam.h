@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "ast/ast.h"
+#include "util/statistics.h"
 #include "smt/smt_types.h"
 #include <tuple>
 
@@ -26,6 +27,17 @@ namespace smt {
 
     class context;
 
+    struct mam_stats {
+        unsigned m_num_candidates = 0;     // enodes queued for matching
+        unsigned m_num_filtered = 0;       // candidates dropped before execution
+        unsigned m_num_executions = 0;     // candidates the code trees were executed on
+        unsigned m_num_matches = 0;        // YIELD instructions reached
+        uint64_t m_num_instructions = 0;   // instructions executed
+
+        void add(mam_stats const & st);
+        void collect_statistics(::statistics & st) const;
+    };
+
     /**
        \brief Matching Abstract Machine (MAM)
     */
@@ -63,6 +75,8 @@ namespace smt {
         
         virtual bool is_shared(enode * n) const = 0;
 
+        virtual void add_statistics(mam_stats & st) const = 0;
+
 #ifdef Z3DEBUG
         virtual bool check_missing_instances() = 0;
 #endif
@@ -0,0 +1,252 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    qi_profiler.cpp
+
+Abstract:
+
+    Profiler for quantifier instantiation.
+
+--*/
+
+#include "ast/ast_pp.h"
+#include "util/warning.h"
+#include "smt/qi_profiler.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace smt {
+
+    static double to_seconds(uint64_t ns) {
+        return static_cast<double>(ns) / 1e9;
+    }
+
+    static void display_json_string(std::ostream & out, std::string const & s) {
+        out << '"';
+        for (char c : s) {
+            switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned>(c) << std::dec << std::setfill(' ');
+                else
+                    out << c;
+            }
+        }
+        out << '"';
+    }
+
+    static void display_csv_string(std::ostream & out, std::string const & s) {
+        out << '"';
+        for (char c : s) {
+            if (c == '"')
+                out << '"';
+            out << c;
+        }
+        out << '"';
+    }
+
+    qi_profiler::scoped_instance::scoped_instance(qi_profiler * p, quantifier * q, app * pat): m_profiler(p) {
+        if (!p)
+            return;
+        m_id = p->mk_entry(q, pat);
+        m_start = clock::now();
+    }
+
+    qi_profiler::scoped_instance::~scoped_instance() {
+        if (!m_profiler)
+            return;
+        m_profiler->m_entries[m_id].m_instantiate_ns += elapsed_ns(m_start, clock::now());
+    }
+
+    void qi_profiler::scoped_instance::internalize_start(unsigned num_bool_vars) {
+        if (!m_profiler)
+            return;
+        clock::time_point now = clock::now();
+        m_profiler->m_entries[m_id].m_instantiate_ns += elapsed_ns(m_start, now);
+        m_start = now;
+        m_num_vars = num_bool_vars;
+    }
+
+    void qi_profiler::scoped_instance::internalize_end(unsigned num_bool_vars, unsigned generation) {
+        if (!m_profiler)
+            return;
+        clock::time_point now = clock::now();
+        entry & e = m_profiler->m_entries[m_id];
+        e.m_internalize_ns += elapsed_ns(m_start, now);
+        e.m_num_instances++;
+        e.m_max_generation = std::max(e.m_max_generation, generation);
+        m_start = now;
+        unsigned_vector & owner = m_profiler->m_var2entry;
+        if (num_bool_vars > m_num_vars) {
+            owner.resize(m_num_vars, UINT_MAX);
+            owner.resize(num_bool_vars, m_id);
+        }
+    }
+
+    unsigned qi_profiler::mk_entry(quantifier * q, app * pat) {
+        ast * k2 = pat ? static_cast<ast*>(pat) : static_cast<ast*>(q);
+        unsigned id = 0;
+        if (m_ids.find(q, k2, id))
+            return id;
+        id = m_entries.size();
+        m_entries.push_back(entry(q, pat));
+        m_ids.insert(q, k2, id);
+        m_pinned.push_back(q);
+        if (pat)
+            m_pinned.push_back(pat);
+        return id;
+    }
+
+    void qi_profiler::start_matching() {
+        if (m_matching)
+            return;
+        m_matching = true;
+        m_mark = clock::now();
+    }
+
+    void qi_profiler::stop_matching() {
+        if (!m_matching)
+            return;
+        m_matching = false;
+        m_match_ns += elapsed_ns(m_mark, clock::now());
+    }
+
+    void qi_profiler::match_eh(quantifier * q, app * pat, bool is_new) {
+        entry & e = m_entries[mk_entry(q, pat)];
+        e.m_num_matches++;
+        if (is_new)
+            e.m_num_new_matches++;
+        if (m_matching) {
+            clock::time_point now = clock::now();
+            e.m_match_ns += elapsed_ns(m_mark, now);
+            m_mark = now;
+        }
+    }
+
+    /**
+       \brief statistics keep the key pointers, so the keys of an entry are
+       created when statistics are first collected and owned by the profiler.
+       They remain valid as long as the context that owns the profiler.
+    */
+    char const * qi_profiler::key(unsigned id, unsigned k, char const * suffix) const {
+        unsigned idx = 4 * id + k;
+        m_keys.reserve(idx + 1);
+        if (!m_keys[idx])
+            m_keys.set(idx, alloc(std::string, "qi profile " + label(m_entries[id]) + suffix));
+        return m_keys[idx]->c_str();
+    }
+
+    int qi_profiler::pattern_index(entry const & e) const {
+        if (!e.m_pat)
+            return -1;
+        for (unsigned i = 0; i < e.m_q->get_num_patterns(); ++i)
+            if (e.m_q->get_pattern(i) == e.m_pat)
+                return i;
+        return -1;
+    }
+
+    std::string qi_profiler::label(entry const & e) const {
+        std::string r = e.m_q->get_qid().str();
+        int idx = pattern_index(e);
+        if (idx >= 0)
+            r += "#" + std::to_string(idx);
+        else if (e.m_pat)
+            r += "#?";
+        return r;
+    }
+
+    std::string qi_profiler::pattern_string(entry const & e) const {
+        if (!e.m_pat)
+            return std::string();
+        std::ostringstream strm;
+        strm << mk_pp(e.m_pat, m);
+        return strm.str();
+    }
+
+    void qi_profiler::collect_statistics(::statistics & st) const {
+        unsigned num_instances = 0, num_conflicts = 0;
+        uint64_t match_ns = m_match_ns, instantiate_ns = 0, internalize_ns = 0;
+        for (unsigned id = 0; id < m_entries.size(); ++id) {
+            entry const & e = m_entries[id];
+            num_instances += e.m_num_instances;
+            num_conflicts += e.m_num_conflicts;
+            match_ns += e.m_match_ns;
+            instantiate_ns += e.m_instantiate_ns;
+            internalize_ns += e.m_internalize_ns;
+            if (e.m_num_matches == 0 && e.m_num_instances == 0)
+                continue;
+            st.update(key(id, 0, " matches"), e.m_num_matches);
+            st.update(key(id, 1, " instances"), e.m_num_instances);
+            st.update(key(id, 2, " conflicts"), e.m_num_conflicts);
+            st.update(key(id, 3, " time"), to_seconds(e.total_ns()));
+        }
+        st.update("qi profile instances", num_instances);
+        st.update("qi profile instance conflicts", num_conflicts);
+        st.update("qi profile match time", to_seconds(match_ns));
+        st.update("qi profile unattributed match time", to_seconds(m_match_ns));
+        st.update("qi profile instantiate time", to_seconds(instantiate_ns));
+        st.update("qi profile internalize time", to_seconds(internalize_ns));
+    }
+
+    std::ostream & qi_profiler::display_json(std::ostream & out) const {
+        out << "{\n  \"conflicts\": " << m_num_conflicts
+            << ",\n  \"unattributed_match_time\": " << to_seconds(m_match_ns)
+            << ",\n  \"profile\": [";
+        bool first = true;
+        for (entry const & e : m_entries) {
+            out << (first ? "\n" : ",\n") << "    {\"qid\": ";
+            first = false;
+            display_json_string(out, e.m_q->get_qid().str());
+            out << ", \"pattern_index\": " << pattern_index(e) << ", \"pattern\": ";
+            display_json_string(out, pattern_string(e));
+            out << ", \"matches\": " << e.m_num_matches
+                << ", \"new_matches\": " << e.m_num_new_matches
+                << ", \"instances\": " << e.m_num_instances
+                << ", \"conflicts\": " << e.m_num_conflicts
+                << ", \"max_generation\": " << e.m_max_generation
+                << ", \"match_time\": " << to_seconds(e.m_match_ns)
+                << ", \"instantiate_time\": " << to_seconds(e.m_instantiate_ns)
+                << ", \"internalize_time\": " << to_seconds(e.m_internalize_ns) << "}";
+        }
+        return out << "\n  ]\n}\n";
+    }
+
+    std::ostream & qi_profiler::display_csv(std::ostream & out) const {
+        out << "qid,pattern_index,pattern,matches,new_matches,instances,conflicts,max_generation,match_time,instantiate_time,internalize_time\n";
+        for (entry const & e : m_entries) {
+            display_csv_string(out, e.m_q->get_qid().str());
+            out << "," << pattern_index(e) << ",";
+            display_csv_string(out, pattern_string(e));
+            out << "," << e.m_num_matches
+                << "," << e.m_num_new_matches
+                << "," << e.m_num_instances
+                << "," << e.m_num_conflicts
+                << "," << e.m_max_generation
+                << "," << to_seconds(e.m_match_ns)
+                << "," << to_seconds(e.m_instantiate_ns)
+                << "," << to_seconds(e.m_internalize_ns) << "\n";
+        }
+        return out;
+    }
+
+    void qi_profiler::export_profile(std::string const & file) const {
+        std::ofstream out(file);
+        if (!out) {
+            warning_msg("could not open file '%s' for the quantifier instantiation profile", file.c_str());
+            return;
+        }
+        bool is_csv = file.size() >= 4 && file.compare(file.size() - 4, 4, ".csv") == 0;
+        if (is_csv)
+            display_csv(out);
+        else
+            display_json(out);
+    }
+}
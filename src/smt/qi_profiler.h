@@ -0,0 +1,139 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    qi_profiler.h
+
+Abstract:
+
+    Profiler for quantifier instantiation.
+
+    Instances, conflicts and time are attributed to the pair
+    (quantifier, pattern) that produced an instance. Instances
+    that are not produced by E-matching (MBQI, user instances)
+    are attributed to the quantifier with a null pattern.
+
+    - E-matching time between two matches is attributed to the
+      pattern of the second match. Time spent after the last match
+      of a round is reported as unattributed.
+    - Instantiation time covers substitution, simplification and
+      the checks that may discard the instance.
+    - Internalization time covers asserting the instance.
+    - A conflict is attributed to an instance when conflict
+      resolution processes an atom whose Boolean variable was
+      created while the instance was internalized. Each conflict
+      is counted at most once per (quantifier, pattern).
+
+    The profile is enabled by smt.qi.profile. It is reported
+    through the statistics object and written to
+    smt.qi.profile_file at the end of each check.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/obj_pair_hashtable.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/statistics.h"
+#include "smt/smt_types.h"
+#include <chrono>
+
+namespace smt {
+
+    class qi_profiler {
+    public:
+        struct entry {
+            quantifier * m_q;
+            app *        m_pat;                     // nullptr if the instances were not found by E-matching
+            unsigned     m_num_matches = 0;         // matches reported by E-matching
+            unsigned     m_num_new_matches = 0;     // matches with bindings that were not seen before
+            unsigned     m_num_instances = 0;       // instances asserted in the context
+            unsigned     m_num_conflicts = 0;       // conflicts that resolved an atom introduced by an instance
+            unsigned     m_max_generation = 0;
+            unsigned     m_last_conflict = 0;
+            uint64_t     m_match_ns = 0;
+            uint64_t     m_instantiate_ns = 0;
+            uint64_t     m_internalize_ns = 0;
+            entry(quantifier * q, app * pat): m_q(q), m_pat(pat) {}
+            uint64_t total_ns() const { return m_match_ns + m_instantiate_ns + m_internalize_ns; }
+        };
+
+        /**
+           \brief Measure the instantiation and internalization of one instance.
+        */
+        class scoped_instance {
+            qi_profiler *                 m_profiler;
+            unsigned                      m_id = UINT_MAX;
+            unsigned                      m_num_vars = 0;
+            std::chrono::steady_clock::time_point m_start;
+        public:
+            scoped_instance(qi_profiler * p, quantifier * q, app * pat);
+            ~scoped_instance();
+            void internalize_start(unsigned num_bool_vars);
+            void internalize_end(unsigned num_bool_vars, unsigned generation);
+        };
+
+    private:
+        typedef std::chrono::steady_clock clock;
+        ast_manager &                         m;
+        ast_ref_vector                        m_pinned;
+        obj_pair_map<ast, ast, unsigned>      m_ids;
+        svector<entry>                        m_entries;
+        unsigned_vector                       m_var2entry;   // instance that introduced a Boolean variable
+        unsigned                              m_num_conflicts = 0;
+        bool                                  m_matching = false;
+        clock::time_point                     m_mark;
+        uint64_t                              m_match_ns = 0; // E-matching time that was not followed by a match
+        mutable scoped_ptr_vector<std::string> m_keys;       // statistics keys of entries, they are referenced by statistics objects
+
+        static uint64_t elapsed_ns(clock::time_point start, clock::time_point end) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+
+        char const * key(unsigned id, unsigned k, char const * suffix) const;
+        int pattern_index(entry const & e) const;
+        std::string label(entry const & e) const;
+        std::string pattern_string(entry const & e) const;
+
+    public:
+        qi_profiler(ast_manager & m): m(m), m_pinned(m) {}
+
+        unsigned mk_entry(quantifier * q, app * pat);
+        entry const & operator[](unsigned id) const { return m_entries[id]; }
+        unsigned size() const { return m_entries.size(); }
+
+        void start_matching();
+        void stop_matching();
+        void match_eh(quantifier * q, app * pat, bool is_new);
+
+        void conflict_eh() { ++m_num_conflicts; }
+
+        void resolve_eh(bool_var v) {
+            if (v >= m_var2entry.size() || m_var2entry[v] == UINT_MAX)
+                return;
+            entry & e = m_entries[m_var2entry[v]];
+            if (e.m_last_conflict != m_num_conflicts) {
+                e.m_last_conflict = m_num_conflicts;
+                e.m_num_conflicts++;
+            }
+        }
+
+        /**
+           \brief Boolean variables at or above num_bool_vars were deleted by backtracking.
+        */
+        void pop_vars(unsigned num_bool_vars) {
+            if (m_var2entry.size() > num_bool_vars)
+                m_var2entry.shrink(num_bool_vars);
+        }
+
+        void collect_statistics(::statistics & st) const;
+        std::ostream & display_json(std::ostream & out) const;
+        std::ostream & display_csv(std::ostream & out) const;
+
+        /**
+           \brief Write the profile to file, in CSV format if the name ends with .csv and in JSON format otherwise.
+        */
+        void export_profile(std::string const & file) const;
+    };
+}
@@ -38,6 +38,7 @@ namespace smt {
         m_parser(m),
         m_evaluator(m),
         m_subst(m),
+        m_instance_cache(m),
         m_instances(m) {
         init_parser_vars();
         m_vals.resize(15, 0.0f);
@@ -60,7 +61,10 @@ namespace smt {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        m_evaluator.compile(m_cost_function, m_cost_program);
+        m_evaluator.compile(m_new_gen_function, m_new_gen_program);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
+        m_instance_cache.set_max_memory(static_cast<size_t>(m_params.m_qi_instance_cache) * 1024 * 1024);
     }
 
     void qi_queue::init_parser_vars() {
@@ -96,59 +100,85 @@ namespace smt {
         m_parser.add_var("cs_factor");
     }
 
-    q::quantifier_stat * qi_queue::set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost) {
+    q::quantifier_stat * qi_queue::set_quantifier_values(quantifier * q) {
         q::quantifier_stat * stat     = m_qm.get_stat(q);
-        m_vals[COST]               = cost;
-        m_vals[MIN_TOP_GENERATION] = static_cast<float>(min_top_generation);
-        m_vals[MAX_TOP_GENERATION] = static_cast<float>(max_top_generation);
         m_vals[INSTANCES]          = static_cast<float>(stat->get_num_instances_curr_branch());
         m_vals[SIZE]               = static_cast<float>(stat->get_size());
         m_vals[DEPTH]              = static_cast<float>(stat->get_depth());
-        m_vals[GENERATION]         = static_cast<float>(generation);
         m_vals[QUANT_GENERATION]   = static_cast<float>(stat->get_generation());
         m_vals[WEIGHT]             = static_cast<float>(q->get_weight());
         m_vals[VARS]               = static_cast<float>(q->get_num_decls());
-        m_vals[PATTERN_WIDTH]      = pat ? static_cast<float>(pat->get_num_args()) : 1.0f;
         m_vals[TOTAL_INSTANCES]    = static_cast<float>(stat->get_num_instances_curr_search());
         m_vals[SCOPE]              = static_cast<float>(m_context.get_scope_level());
         m_vals[NESTED_QUANTIFIERS] = static_cast<float>(stat->get_num_nested_quantifiers());
         m_vals[CS_FACTOR]          = static_cast<float>(stat->get_case_split_factor());
-        TRACE(qi_queue_detail, for (unsigned i = 0; i < m_vals.size(); ++i) { tout << m_vals[i] << " "; } tout << "\n";);
         return stat;
     }
 
-    float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
-        q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
-        stat->update_max_cost(r);
-        return r;
+    void qi_queue::set_instance_values(app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost) {
+        m_vals[COST]               = cost;
+        m_vals[MIN_TOP_GENERATION] = static_cast<float>(min_top_generation);
+        m_vals[MAX_TOP_GENERATION] = static_cast<float>(max_top_generation);
+        m_vals[GENERATION]         = static_cast<float>(generation);
+        m_vals[PATTERN_WIDTH]      = pat ? static_cast<float>(pat->get_num_args()) : 1.0f;
+        TRACE(qi_queue_detail, for (unsigned i = 0; i < m_vals.size(); ++i) { tout << m_vals[i] << " "; } tout << "\n";);
     }
 
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
-        set_values(q, nullptr, generation, 0, 0, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        set_quantifier_values(q);
+        set_instance_values(nullptr, generation, 0, 0, cost);
+        float r = m_evaluator(m_new_gen_program, m_vals.size(), m_vals.data());
         if (q->get_weight() > 0 || r > 0)
             return static_cast<unsigned>(r);
         return std::max(generation + 1, static_cast<unsigned>(r));
     }
 
+    /**
+       \brief The cost of an instance is computed in a batch when the queue is processed.
+       The values of the cost function only change when instances are created
+       or the scope level changes, and both flush the pending instances first.
+    */
     void qi_queue::insert(fingerprint * f, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
-        quantifier * q         = static_cast<quantifier*>(f->get_data());
-        float cost             = get_cost(q, pat, generation, min_top_generation, max_top_generation);
-        TRACE(qi_queue_detail,
-              tout << "new instance of " << q->get_qid() << ", weight " << q->get_weight()
-              << ", generation: " << generation << ", scope_level: " << m_context.get_scope_level() << ", cost: " << cost << "\n";
-              for (unsigned i = 0; i < f->get_num_args(); ++i) {
-                  tout << "#" << f->get_arg(i)->get_expr_id() << " d:" << get_depth(f->get_arg(i)->get_expr()) << " ";
-              }
-              tout << "\n";);
         TRACE(new_entries_bug, tout << "[qi:insert]\n";);
-        m_new_entries.push_back(entry(f, cost, generation));
+        m_pending.push_back({ f, pat, generation, min_top_generation, max_top_generation });
+    }
+
+    void qi_queue::insert_batch(unsigned n, instance const * instances) {
+        quantifier * last         = nullptr;
+        q::quantifier_stat * stat = nullptr;
+        for (unsigned i = 0; i < n; ++i) {
+            instance const & inst = instances[i];
+            fingerprint * f       = inst.m_qb;
+            quantifier * q        = static_cast<quantifier*>(f->get_data());
+            if (q != last) {
+                stat = set_quantifier_values(q);
+                last = q;
+            }
+            set_instance_values(inst.m_pat, inst.m_generation, inst.m_min_top_generation, inst.m_max_top_generation, 0);
+            float cost = m_evaluator(m_cost_program, m_vals.size(), m_vals.data());
+            stat->update_max_cost(cost);
+            TRACE(qi_queue_detail,
+                  tout << "new instance of " << q->get_qid() << ", weight " << q->get_weight()
+                  << ", generation: " << inst.m_generation << ", scope_level: " << m_context.get_scope_level() << ", cost: " << cost << "\n";
+                  for (unsigned i = 0; i < f->get_num_args(); ++i) {
+                      tout << "#" << f->get_arg(i)->get_expr_id() << " d:" << get_depth(f->get_arg(i)->get_expr()) << " ";
+                  }
+                  tout << "\n";);
+            m_new_entries.push_back(entry(f, inst.m_pat, cost, inst.m_generation));
+        }
+    }
+
+    void qi_queue::flush_pending() {
+        if (m_pending.empty())
+            return;
+        insert_batch(m_pending.size(), m_pending.data());
+        m_pending.reset();
     }
 
     void qi_queue::instantiate() {
         unsigned since_last_check = 0;
+        flush_pending();
         for (entry & curr : m_new_entries) {
             if (m_context.get_cancel_flag()) {
                 break;
@@ -207,6 +237,7 @@ namespace smt {
         enode * const * bindings = f->get_args();
 
         ent.m_instantiated = true;
+        qi_profiler::scoped_instance _profile(m_context.get_qi_profiler(), q, ent.m_pat);
                 
         TRACE(qi_queue_profile, tout << q->get_qid() << ", gen: " << generation << " " << *f << " cost: " << ent.m_cost << "\n";);
 
@@ -225,16 +256,46 @@ namespace smt {
 
         STRACE(instance, tout << "### " << static_cast<void*>(f) <<", " << q->get_qid()  << "\n";);
 
-        auto* ebindings = m_subst(q, num_bindings);
-        for (unsigned i = 0; i < num_bindings; ++i)
-            ebindings[i] = bindings[i]->get_expr();
-        expr_ref instance = m_subst();
-
-
-        TRACE(qi_queue, tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
+        expr_ref  instance(m);
         expr_ref  s_instance(m);
+        expr_ref  lemma(m);
         proof_ref pr(m);
-        m_context.get_rewriter()(instance, s_instance, pr);
+        // the expressions the instance was created for, a cached instance may use congruent expressions
+        ptr_buffer<expr, 16> inst_bindings;
+        // the proof of the simplification is not cached
+        bool use_cache = m_instance_cache.enabled() && !m.proofs_enabled();
+        instance_cache::instance cached;
+        auto get_enode = [&](expr * e) { return m_context.e_internalized(e) ? m_context.get_enode(e) : nullptr; };
+        if (use_cache && m_instance_cache.find(q, num_bindings, bindings, get_enode, cached)) {
+            instance   = cached.m_instance;
+            s_instance = cached.m_result;
+            lemma      = cached.m_lemma;
+            inst_bindings.append(num_bindings, cached.m_bindings);
+        }
+        else {
+            auto* ebindings = m_subst(q, num_bindings);
+            for (unsigned i = 0; i < num_bindings; ++i) {
+                ebindings[i] = bindings[i]->get_expr();
+                inst_bindings.push_back(ebindings[i]);
+            }
+            instance = m_subst();
+            TRACE(qi_queue, tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
+            m_context.get_rewriter()(instance, s_instance, pr);
+            if (m.is_or(s_instance)) {
+                ptr_vector<expr> args;
+                args.push_back(m.mk_not(q));
+                args.append(to_app(s_instance)->get_num_args(), to_app(s_instance)->get_args());
+                lemma = m.mk_or(args);
+            }
+            else if (m.is_false(s_instance)) {
+                lemma = m.mk_not(q);
+            }
+            else if (!m.is_true(s_instance)) {
+                lemma = m.mk_or(m.mk_not(q), s_instance);
+            }
+            if (use_cache)
+                m_instance_cache.insert(q, num_bindings, bindings, instance, s_instance, lemma);
+        }
 
         TRACE(qi_queue_bug, tout << "new instance after simplification:\n" << s_instance << "\n";);
         if (m.is_true(s_instance)) {
@@ -268,22 +329,6 @@ namespace smt {
             verbose_stream() << "qi_queue: on_binding returned false, skipping instance.\n";
             return;
         }
-        expr_ref lemma(m);
-        if (m.is_or(s_instance)) {
-            ptr_vector<expr> args;
-            args.push_back(m.mk_not(q));
-            args.append(to_app(s_instance)->get_num_args(), to_app(s_instance)->get_args());
-            lemma = m.mk_or(args);
-        }
-        else if (m.is_false(s_instance)) {
-            lemma = m.mk_not(q);
-        }
-        else if (m.is_true(s_instance)) {
-            lemma = s_instance;
-        }
-        else {
-            lemma = m.mk_or(m.mk_not(q), s_instance);
-        }
         m_instances.push_back(lemma);
         proof_ref pr1(m);
         unsigned proof_id = 0;
@@ -313,15 +358,13 @@ namespace smt {
             m_instances.push_back(pr1);
         }
         else if (m_context.clause_proof_active()) {
-            expr_ref_vector bindings_e(m), args(m);
+            expr_ref_vector args(m);
             arith_util a(m);
             expr_ref gen(a.mk_int(generation), m);
             expr* gens[1] = { gen.get() };
-            for (unsigned i = 0; i < num_bindings; ++i) 
-                bindings_e.push_back(bindings[i]->get_expr());
             args.push_back(q);
             args.push_back(mk_not(m, instance));
-            args.push_back(m.mk_app(symbol("bind"), num_bindings, bindings_e.data(), m.mk_proof_sort()));
+            args.push_back(m.mk_app(symbol("bind"), num_bindings, inst_bindings.data(), m.mk_proof_sort()));
             args.push_back(m.mk_app(symbol("gen"), 1, gens, m.mk_proof_sort()));
             pr1 = m.mk_app(symbol("inst"), args.size(), args.data(), m.mk_proof_sort());
             m_instances.push_back(pr1);            
@@ -330,7 +373,9 @@ namespace smt {
         m_stats.m_num_instances++;
         unsigned gen = get_new_gen(q, generation, ent.m_cost);
         display_instance_profile(f, q, num_bindings, bindings, proof_id, gen);
+        _profile.internalize_start(m_context.get_num_bool_vars());
         m_context.internalize_instance(lemma, pr1, gen);
+        _profile.internalize_end(m_context.get_num_bool_vars(), gen);
         TRACE_CODE({
             static unsigned num_useless = 0;
             if (m.is_or(lemma)) {
@@ -363,6 +408,7 @@ namespace smt {
 
     void qi_queue::push_scope() {
         TRACE(new_entries_bug, tout << "[qi:push-scope]\n";);
+        flush_pending();
         m_scopes.push_back(scope());
         SASSERT(m_context.inconsistent() || m_new_entries.empty());
         scope & s = m_scopes.back();
@@ -382,12 +428,14 @@ namespace smt {
         m_delayed_entries.shrink(s.m_delayed_entries_lim);
         m_instances.shrink(s.m_instances_lim);
         m_new_entries.reset();
+        m_pending.reset();
         m_scopes.shrink(new_lvl);
         TRACE(new_entries_bug, tout << "[qi:pop-scope]\n";);
     }
 
     void qi_queue::reset() {
         m_new_entries.reset();
+        m_pending.reset();
         m_delayed_entries.reset();
         m_instances.reset();
         m_scopes.reset();
@@ -396,9 +444,11 @@ namespace smt {
     void qi_queue::init_search_eh() {
         m_subst.reset();
         m_new_entries.reset();
+        m_pending.reset();
     }
 
     bool qi_queue::final_check_eh() {
+        flush_pending();
         TRACE(qi_queue, display_delayed_instances_stats(tout); tout << "lazy threshold: " << m_params.m_qi_lazy_threshold
               << ", scope_level: " << m_context.get_scope_level() << "\n";);
 
@@ -510,6 +560,8 @@ namespace smt {
         get_min_max_costs(min, max);
         st.update("min missed qa cost", min);
         st.update("max missed qa cost", max);
+        if (m_instance_cache.enabled())
+            m_instance_cache.collect_statistics(st);
 #if 0
         if (m_params.m_qi_profile) {
             out << "missed/delayed quantifier instances:\n";
@@ -50,18 +50,35 @@ namespace smt {
         expr_ref                      m_new_gen_function;
         cost_parser                   m_parser;
         cost_evaluator                m_evaluator;
+        cost_evaluator::program       m_cost_program;
+        cost_evaluator::program       m_new_gen_program;
         cached_var_subst              m_subst;
+        instance_cache                m_instance_cache;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold = 0;
         std::function<bool(quantifier*,expr*)> m_on_binding;
+    public:
+        /**
+           \brief A quantifier instance found by matching, f->get_data() is the quantifier.
+        */
+        struct instance {
+            fingerprint * m_qb;
+            app *         m_pat;
+            unsigned      m_generation;
+            unsigned      m_min_top_generation;
+            unsigned      m_max_top_generation;
+        };
+    private:
         struct entry {
             fingerprint * m_qb;
+            app *         m_pat;
             float         m_cost;
             unsigned      m_generation:31;
             unsigned      m_instantiated:1;
-            entry(fingerprint * f, float c, unsigned g):m_qb(f), m_cost(c), m_generation(g), m_instantiated(false) {}
+            entry(fingerprint * f, app * pat, float c, unsigned g):m_qb(f), m_pat(pat), m_cost(c), m_generation(g), m_instantiated(false) {}
         };
         svector<entry>                m_new_entries;
+        svector<instance>             m_pending;      // new instances whose cost has not been computed
         svector<entry>                m_delayed_entries;
         expr_ref_vector               m_instances;
         unsigned_vector               m_instantiated_trail;
@@ -73,8 +90,9 @@ namespace smt {
         svector<scope>                m_scopes;
 
         void init_parser_vars();
-        q::quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
-        float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
+        q::quantifier_stat * set_quantifier_values(quantifier * q);
+        void set_instance_values(app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
+        void flush_pending();
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
         void instantiate(entry & ent);
         void get_min_max_costs(float & min, float & max) const;
@@ -88,8 +106,14 @@ namespace smt {
            f->get_data() is the quantifier.
         */
         void insert(fingerprint * f, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
+        /**
+           \brief Compute the costs of a sequence of instances and queue them.
+           The values that only depend on the quantifier are computed once for
+           each run of instances of the same quantifier.
+        */
+        void insert_batch(unsigned n, instance const * instances);
         void instantiate();
-        bool has_work() const { return !m_new_entries.empty(); }
+        bool has_work() const { return !m_new_entries.empty() || !m_pending.empty(); }
         void init_search_eh();
         bool final_check_eh();
         void push_scope();
@@ -320,6 +320,8 @@ namespace smt {
         if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
             m_ctx.set_mark(var);
             m_ctx.inc_bvar_activity(var);
+            if (qi_profiler * p = m_ctx.get_qi_profiler())
+                p->resolve_eh(var);
             expr * n = m_ctx.bool_var2expr(var);
             if (is_app(n)) {
                 family_id fid = to_app(n)->get_family_id();
@@ -641,6 +643,10 @@ namespace smt {
         bool_var var = antecedent.var();
         unsigned lvl = m_ctx.get_assign_level(var);
         if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
+            if (is_min_failed(var)) {
+                m_ctx.m_stats.m_num_minimize_cache_hits++;
+                return false;
+            }
             if (m_lvl_set.may_contain(lvl)) {
                 m_ctx.set_mark(var);
                 m_unmark.push_back(var);
@@ -654,15 +660,24 @@ namespace smt {
     }
 
     bool conflict_resolution::process_justification_for_minimization(justification * js) {
+        if (m_min_failed_js.contains(js)) {
+            m_ctx.m_stats.m_num_minimize_cache_hits++;
+            return false;
+        }
         literal_vector & antecedents = m_tmp_literal_vector;
         antecedents.reset();
         // Invoking justification2literals_core will not reset the caches for visited justifications and eqs.
         // The method unmark_justifications must be invoked to reset these caches.
         // Remark: The method reset_unmark_and_justifications invokes unmark_justifications.
         justification2literals_core(js, antecedents);
-        for (literal l : antecedents) 
-            if (!process_antecedent_for_minimization(l))
+        for (literal l : antecedents) {
+            if (!process_antecedent_for_minimization(l)) {
+                // the antecedents of theory justifications are expensive to compute, remember the failure.
+                if (m_params.m_minimize_cache)
+                    m_min_failed_js.insert(js);
                 return false;
+            }
+        }
         return true;
     }
 
@@ -672,12 +687,20 @@ namespace smt {
        The set lvl_set is used as an optimization.
        The idea is to stop the recursive search with a failure
        as soon as we find a literal assigned in a level that is not in lvl_set.
+       The variable whose antecedents caused a failure is not implied either,
+       it is cached so that later searches fail without expanding it again.
     */
     bool conflict_resolution::implied_by_marked(literal lit) {
         m_lemma_min_stack.reset();  // avoid recursive function
         m_lemma_min_stack.push_back(lit.var());
         unsigned old_size     = m_unmark.size();
         unsigned old_js_qhead = m_todo_js_qhead;
+        auto fail = [&](bool_var v) {
+            if (m_params.m_minimize_cache)
+                set_min_failed(v);
+            reset_unmark_and_justifications(old_size, old_js_qhead);
+            return false;
+        };
 
         while (!m_lemma_min_stack.empty()) {
             bool_var var       = m_lemma_min_stack.back();
@@ -694,35 +717,30 @@ namespace smt {
                         literal l = (*cls)[i];
                         SASSERT(l.var() != var);
                         if (!process_antecedent_for_minimization(~l)) {
-                            reset_unmark_and_justifications(old_size, old_js_qhead);
-                            return false;
+                            return fail(var);
                         }
                     }
                 }
                 justification * js = cls->get_justification();
                 if (js && !process_justification_for_minimization(js)) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return fail(var);
                 }
                 break;
             }
             case b_justification::BIN_CLAUSE:
                 if (!process_antecedent_for_minimization(js.get_literal())) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return fail(var);
                 }
                 break;
             case b_justification::AXIOM:
                 // it is a decision variable from a previous scope level or an assumption
                 if (m_ctx.get_assign_level(var) > m_ctx.get_base_level()) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return fail(var);
                 }
                 break;
             case b_justification::JUSTIFICATION:
                 if (m_ctx.is_assumption(var) || !process_justification_for_minimization(js.get_justification())) {
-                    reset_unmark_and_justifications(old_size, old_js_qhead);
-                    return false;
+                    return fail(var);
                 }
                 break;
             }
@@ -737,6 +755,11 @@ namespace smt {
     */
     void conflict_resolution::minimize_lemma() {
         m_unmark.reset();
+        m_min_failed_js.reset();
+        if (++m_min_stamp == 0) {
+            m_min_failed.reset();
+            m_min_stamp = 1;
+        }
 
         m_lvl_set   = get_lemma_approx_level_set();
 
@@ -182,9 +182,17 @@ namespace smt {
         bool_var_vector m_unmark;
         bool_var_vector m_lemma_min_stack;
         level_approx_set m_lvl_set;
+        // Literals and justifications that are known not to be implied by the lemma
+        // in the current minimization. A variable v is in the set if m_min_failed[v] == m_min_stamp.
+        // Implied literals remain marked until the end of the minimization.
+        unsigned_vector m_min_failed;
+        unsigned m_min_stamp = 0;
+        ptr_addr_hashtable<justification> m_min_failed_js;
         level_approx_set get_lemma_approx_level_set();
         void reset_unmark(unsigned old_size);
         void reset_unmark_and_justifications(unsigned old_size, unsigned old_js_qhead);
+        bool is_min_failed(bool_var v) const { return v < m_min_failed.size() && m_min_failed[v] == m_min_stamp; }
+        void set_min_failed(bool_var v) { m_min_failed.reserve(v + 1, 0); m_min_failed[v] = m_min_stamp; }
         bool process_antecedent_for_minimization(literal antecedent);
         bool process_justification_for_minimization(justification * js);
         bool implied_by_marked(literal lit);
@@ -88,6 +88,8 @@ namespace smt {
 
         m_case_split_queue = mk_case_split_queue(*this, p);
         m_rewriter.updt_params(m_asserted_formulas.get_params());
+        if (m_fparams.m_qi_profile)
+            m_qi_profiler = alloc(qi_profiler, m);
 
         init();
 
@@ -2568,6 +2570,8 @@ namespace smt {
 
             unassign_vars(s.m_assigned_literals_lim);
             m_trail_stack.pop_scope(num_scopes);
+            if (m_qi_profiler)
+                m_qi_profiler->pop_vars(get_num_bool_vars());
 
             for (theory* th : m_theory_set) 
                 th->pop_scope_eh(num_scopes);
@@ -3399,6 +3403,9 @@ namespace smt {
         }
         while (qhead < m_asserted_formulas.get_num_formulas());
 
+        if (m_learned_import && m_scope_lvl == 0 && !inconsistent())
+            add_imported_learned();
+
         TRACE(internalize_assertions, tout << "after internalize_assertions()...\n";
               tout << "inconsistent: " << inconsistent() << "\n";);
         TRACE(after_internalize_assertions, display(tout););
@@ -3622,6 +3629,8 @@ namespace smt {
               );
         m_search_finalized = true;
         display_profile(verbose_stream());
+        if (m_qi_profiler && !m_is_auxiliary && !m_fparams.m_qi_profile_file.empty())
+            m_qi_profiler->export_profile(m_fparams.m_qi_profile_file);
         if (r == l_true && get_cancel_flag()) 
             r = l_undef;
         if (r == l_undef && m_internal_completed == l_true && has_sls_model()) {
@@ -4353,6 +4362,8 @@ namespace smt {
         m_eq_propagation_queue.reset();
         m_th_eq_propagation_queue.reset();
         m_th_diseq_propagation_queue.reset();
+        if (m_qi_profiler)
+            m_qi_profiler->conflict_eh();
         if (m_conflict_resolution->resolve(m_conflict, m_not_l)) {
             unsigned new_lvl = m_conflict_resolution->get_new_scope_lvl();
             unsigned num_lits = m_conflict_resolution->get_lemma_num_literals();
@@ -32,12 +32,14 @@ Revision History:
 #include "smt/smt_clause_proof.h"
 #include "smt/smt_theory.h"
 #include "smt/smt_quantifier.h"
+#include "smt/qi_profiler.h"
 #include "smt/smt_statistics.h"
 #include "smt/smt_conflict_resolution.h"
 #include "smt/smt_relevancy.h"
 #include "smt/smt_case_split_queue.h"
 #include "smt/smt_almost_cg_table.h"
 #include "smt/smt_failure.h"
+#include "smt/smt_learned_clauses.h"
 #include "smt/smt_types.h"
 #include "smt/dyn_ack.h"
 #include "ast/ast_smt_pp.h"
@@ -91,6 +93,7 @@ namespace smt {
         friend class lookahead;
         friend class parallel;
         friend class kernel;
+        friend class model_checker;
     public:
         statistics                  m_stats;
 
@@ -112,6 +115,7 @@ namespace smt {
         asserted_formulas           m_asserted_formulas;
         th_rewriter                 m_rewriter;
         scoped_ptr<quantifier_manager>   m_qmanager;
+        scoped_ptr<qi_profiler>          m_qi_profiler; // enabled by smt.qi.profile
         scoped_ptr<model_generator>      m_model_generator;
         scoped_ptr<relevancy_propagator> m_relevancy_propagator;
         theory_user_propagator*          m_user_propagator;
@@ -229,6 +233,7 @@ namespace smt {
         literal                     m_not_l;
         scoped_ptr<conflict_resolution> m_conflict_resolution;
         proof_ref                   m_unsat_proof;
+        scoped_ptr<learned_clauses> m_learned_import;   // imported clauses waiting for the assertions to be internalized
 
 
         literal_vector              m_atom_propagation_queue;
@@ -303,6 +308,10 @@ namespace smt {
             return m_fparams;
         }
 
+        qi_profiler * get_qi_profiler() const {
+            return m_qi_profiler.get();
+        }
+
         params_ref const & get_params() {
             return m_params;
         }
@@ -326,6 +335,13 @@ namespace smt {
 
         unsigned relevancy_lvl() const;
 
+        /**
+           \brief Watches for the relevancy of Boolean gates are installed when the gate becomes relevant.
+        */
+        bool lazy_relevancy() const {
+            return relevancy_lvl() > 2;
+        }
+
         enode * get_enode(expr const * n) const {
             SASSERT(e_internalized(n));
             return m_app2enode[n->get_id()];
@@ -1311,6 +1327,8 @@ namespace smt {
 
         void asserted_inconsistent();
 
+        void add_imported_learned();
+
         bool validate_assumptions(expr_ref_vector const& asms);
 
         void init_assumptions(expr_ref_vector const& asms);
@@ -1828,6 +1846,20 @@ namespace smt {
 
         void get_units(expr_ref_vector& result);
 
+        /**
+           \brief Save the learned clauses over user-visible atoms, and the activities
+           and phases of these atoms, in the format described in smt_learned_clauses.h.
+        */
+        void export_learned(std::ostream & out);
+
+        /**
+           \brief Load clauses saved by export_learned. They are added at the next
+           check, after the assertions have been internalized. Clauses that use
+           atoms not known to this context are dropped. The import is rejected
+           when there are user scopes.
+        */
+        void import_learned(std::istream & in);
+
         bool clause_proof_active() const { return m_clause_proof.is_enabled(); }
 
         clause_proof& get_clause_proof() { return m_clause_proof; }
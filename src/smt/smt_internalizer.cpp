@@ -1723,6 +1723,10 @@ namespace smt {
     void context::add_and_rel_watches(app * n) {
         if (relevancy()) {
             relevancy_eh * eh = m_relevancy_propagator->mk_and_relevancy_eh(n);
+            if (lazy_relevancy()) {
+                m_relevancy_propagator->add_lazy_watches(n, eh);
+                return;
+            }
             for (expr * arg : *n) {
                 // if one child is assigned to false, the and-parent must be notified
                 literal l = get_literal(arg);
@@ -1734,6 +1738,10 @@ namespace smt {
     void context::add_or_rel_watches(app * n) {
         if (relevancy()) {
             relevancy_eh * eh = m_relevancy_propagator->mk_or_relevancy_eh(n);
+            if (lazy_relevancy()) {
+                m_relevancy_propagator->add_lazy_watches(n, eh);
+                return;
+            }
             for (expr * arg : *n) {
                 // if one child is assigned to true, the or-parent must be notified
                 literal l = get_literal(arg);
@@ -1745,6 +1753,10 @@ namespace smt {
     void context::add_implies_rel_watches(app* n) {
         if (relevancy()) {
             relevancy_eh* eh = m_relevancy_propagator->mk_implies_relevancy_eh(n);
+            if (lazy_relevancy()) {
+                m_relevancy_propagator->add_lazy_watches(n, eh);
+                return;
+            }
             add_rel_watch(~get_literal(n->get_arg(0)), eh);
             add_rel_watch(get_literal(n->get_arg(1)), eh);
         }
@@ -304,6 +304,14 @@ namespace smt {
         return m_imp->m_kernel.get_trail(max_level);
     }
 
+    void kernel::export_learned(std::ostream & out) {
+        m_imp->m_kernel.export_learned(out);
+    }
+
+    void kernel::import_learned(std::istream & in) {
+        m_imp->m_kernel.import_learned(in);
+    }
+
     void kernel::user_propagate_init(
         void*                ctx, 
         user_propagator::push_eh_t&   push_eh,
@@ -260,6 +260,16 @@ namespace smt {
         */
         expr_ref_vector get_trail(unsigned max_level);
 
+        /**
+           \brief Save the learned clauses over user-visible atoms, with the activities and phases of these atoms.
+        */
+        void export_learned(std::ostream & out);
+
+        /**
+           \brief Load clauses saved by export_learned. They are added after the assertions are internalized by the next check.
+        */
+        void import_learned(std::istream & in);
+
         /**
            \brief (For debugging purposes) Prints the state of the kernel
         */
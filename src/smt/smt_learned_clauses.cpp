@@ -0,0 +1,322 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_learned_clauses.cpp
+
+Abstract:
+
+    Export and import of learned clauses.
+
+    Learned clauses are consequences of the assertions, so they can be
+    added as theory lemmas to any context that has the same assertions.
+    Clauses learned inside user scopes may depend on the assertions of
+    these scopes and are not exported.
+
+--*/
+
+#include "util/map.h"
+#include "smt/smt_context.h"
+#include "smt/smt_learned_clauses.h"
+#include <cstring>
+#include <sstream>
+
+namespace smt {
+
+    static const char     lc_magic[4] = { 'Z', '3', 'L', 'C' };
+    static const unsigned lc_version = 1;
+    static const unsigned lc_max_atom_size = 256;   // maximal number of distinct sub-terms of an exported atom
+
+    static void write_uint(std::ostream & out, unsigned n) {
+        while (n >= 0x80) {
+            out.put(static_cast<char>((n & 0x7F) | 0x80));
+            n >>= 7;
+        }
+        out.put(static_cast<char>(n));
+    }
+
+    static bool read_uint(std::istream & in, unsigned & n) {
+        n = 0;
+        for (unsigned shift = 0; shift < 35; shift += 7) {
+            int c = in.get();
+            if (c == EOF)
+                return false;
+            n |= static_cast<unsigned>(c & 0x7F) << shift;
+            if (!(c & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    static void write_fixed(std::ostream & out, uint64_t n, unsigned num_bytes) {
+        for (unsigned i = 0; i < num_bytes; ++i, n >>= 8)
+            out.put(static_cast<char>(n & 0xFF));
+    }
+
+    static bool read_fixed(std::istream & in, uint64_t & n, unsigned num_bytes) {
+        n = 0;
+        for (unsigned i = 0; i < num_bytes; ++i) {
+            int c = in.get();
+            if (c == EOF)
+                return false;
+            n |= static_cast<uint64_t>(c & 0xFF) << (8 * i);
+        }
+        return true;
+    }
+
+    void learned_clauses::write(std::ostream & out) const {
+        out.write(lc_magic, sizeof(lc_magic));
+        out.put(static_cast<char>(lc_version));
+        write_uint(out, m_atoms.size());
+        for (atom const & a : m_atoms) {
+            uint64_t act;
+            static_assert(sizeof(act) == sizeof(a.m_activity), "double is expected to have 64 bits");
+            memcpy(&act, &a.m_activity, sizeof(act));
+            write_fixed(out, a.m_hash, 4);
+            write_uint(out, static_cast<unsigned>(a.m_text.size()));
+            out.write(a.m_text.data(), a.m_text.size());
+            write_fixed(out, act, 8);
+            out.put(static_cast<char>(a.m_phase));
+        }
+        write_uint(out, m_clauses.size());
+        for (unsigned_vector const & c : m_clauses) {
+            write_uint(out, c.size());
+            for (unsigned lit : c)
+                write_uint(out, lit);
+        }
+    }
+
+    bool learned_clauses::read(std::istream & in) {
+        char magic[sizeof(lc_magic)];
+        if (!in.read(magic, sizeof(magic)) || memcmp(magic, lc_magic, sizeof(magic)) != 0)
+            return false;
+        if (in.get() != static_cast<int>(lc_version))
+            return false;
+        unsigned num_atoms = 0, num_clauses = 0, sz = 0;
+        uint64_t n = 0;
+        if (!read_uint(in, num_atoms))
+            return false;
+        for (unsigned i = 0; i < num_atoms; ++i) {
+            atom a;
+            if (!read_fixed(in, n, 4))
+                return false;
+            a.m_hash = static_cast<unsigned>(n);
+            if (!read_uint(in, sz))
+                return false;
+            a.m_text.resize(sz);
+            if (sz > 0 && !in.read(&a.m_text[0], sz))
+                return false;
+            if (!read_fixed(in, n, 8))
+                return false;
+            memcpy(&a.m_activity, &n, sizeof(n));
+            int phase = in.get();
+            if (phase == EOF || phase > 2)
+                return false;
+            a.m_phase = phase;
+            m_atoms.push_back(std::move(a));
+        }
+        if (!read_uint(in, num_clauses))
+            return false;
+        for (unsigned i = 0; i < num_clauses; ++i) {
+            if (!read_uint(in, sz))
+                return false;
+            m_clauses.push_back(unsigned_vector());
+            unsigned_vector & c = m_clauses.back();
+            for (unsigned j = 0; j < sz; ++j) {
+                unsigned lit;
+                if (!read_uint(in, lit) || (lit >> 1) >= num_atoms)
+                    return false;
+                c.push_back(lit);
+            }
+        }
+        return true;
+    }
+
+    static void display_sort(std::ostream & out, sort * s);
+
+    static void display_parameter(std::ostream & out, parameter const & p) {
+        if (p.is_ast() && is_sort(p.get_ast()))
+            display_sort(out, to_sort(p.get_ast()));
+        else if (p.is_ast() && is_func_decl(p.get_ast()))
+            out << to_func_decl(p.get_ast())->get_name() << "/" << to_func_decl(p.get_ast())->get_arity();
+        else
+            p.display(out);
+    }
+
+    static void display_sort(std::ostream & out, sort * s) {
+        if (s->get_num_parameters() == 0) {
+            out << s->get_name();
+            return;
+        }
+        out << "(" << s->get_name();
+        for (unsigned i = 0; i < s->get_num_parameters(); ++i)
+            display_parameter(out << " ", s->get_parameter(i));
+        out << ")";
+    }
+
+    /**
+       \brief Produce a text that identifies e across processes.
+       The sub-terms of e are listed in post-order, arguments refer to
+       the position of the sub-term in the list. Return false if e is
+       not visible to the user or too large.
+    */
+    static bool atom_text(expr * e, std::string & text) {
+        obj_map<expr, unsigned> ids;
+        ptr_buffer<expr> todo;
+        std::ostringstream out;
+        todo.push_back(e);
+        while (!todo.empty()) {
+            expr * t = todo.back();
+            if (ids.contains(t)) {
+                todo.pop_back();
+                continue;
+            }
+            if (!is_app(t) || to_app(t)->get_decl()->is_skolem() || todo.size() > 4 * lc_max_atom_size)
+                return false;
+            app * a = to_app(t);
+            unsigned sz = todo.size();
+            for (expr * arg : *a)
+                if (!ids.contains(arg))
+                    todo.push_back(arg);
+            if (todo.size() > sz)
+                continue;
+            todo.pop_back();
+            if (ids.size() >= lc_max_atom_size)
+                return false;
+            func_decl * f = a->get_decl();
+            out << "(" << f->get_name();
+            for (unsigned i = 0; i < f->get_num_parameters(); ++i)
+                display_parameter(out << " ", f->get_parameter(i));
+            display_sort(out << " ", f->get_range());
+            for (expr * arg : *a)
+                out << " " << ids[arg];
+            out << ")";
+            ids.insert(t, ids.size());
+        }
+        text = std::move(out).str();
+        return true;
+    }
+
+    void context::export_learned(std::ostream & out) {
+        learned_clauses lc;
+        unsigned_vector var2atom(get_num_bool_vars(), UINT_MAX);
+        double max_activity = 0;
+        // true_bool_var is not exported, clauses containing it are dropped.
+        for (bool_var v = true_bool_var + 1; v < static_cast<bool_var>(get_num_bool_vars()); ++v) {
+            learned_clauses::atom a;
+            expr * e = bool_var2expr(v);
+            if (!atom_text(e, a.m_text))
+                continue;
+            bool_var_data const & d = get_bdata(v);
+            a.m_hash = e->hash();
+            a.m_activity = get_activity(v);
+            a.m_phase = d.m_phase_available ? (d.m_phase ? 2 : 1) : 0;
+            max_activity = std::max(max_activity, a.m_activity);
+            var2atom[v] = lc.m_atoms.size();
+            lc.m_atoms.push_back(std::move(a));
+        }
+        if (max_activity > 0)
+            for (auto & a : lc.m_atoms)
+                a.m_activity /= max_activity;
+
+        auto add_clause = [&](unsigned num_lits, literal const * lits) {
+            unsigned_vector c;
+            for (unsigned i = 0; i < num_lits; ++i) {
+                unsigned idx = var2atom[lits[i].var()];
+                if (idx == UINT_MAX)
+                    return;
+                c.push_back(2 * idx + lits[i].sign());
+            }
+            lc.m_clauses.push_back(std::move(c));
+        };
+        // units and lemmas that were derived outside of user scopes.
+        unsigned num_units = m_scopes.empty() ? m_assigned_literals.size() : m_scopes[0].m_assigned_literals_lim;
+        unsigned num_lemmas = m_base_scopes.empty() ? m_lemmas.size() : m_base_scopes[0].m_lemmas_lim;
+        for (unsigned i = 0; i < num_units; ++i)
+            add_clause(1, m_assigned_literals.data() + i);
+        for (unsigned i = 0; i < num_lemmas; ++i) {
+            clause const & cls = *m_lemmas[i];
+            if (!cls.deleted())
+                add_clause(cls.get_num_literals(), cls.begin());
+        }
+        IF_VERBOSE(2, verbose_stream() << "(smt.export-learned :atoms " << lc.m_atoms.size()
+                   << " :clauses " << lc.m_clauses.size() << ")\n";);
+        lc.write(out);
+    }
+
+    void context::import_learned(std::istream & in) {
+        if (m.proofs_enabled())
+            throw default_exception("learned clauses cannot be imported when proofs are enabled");
+        // imported clauses are added at base level, they would be lost when a user scope is popped.
+        if (m_base_lvl > 0)
+            throw default_exception("learned clauses can only be imported when there are no user scopes");
+        scoped_ptr<learned_clauses> lc = alloc(learned_clauses);
+        if (!lc->read(in))
+            throw default_exception("malformed file of learned clauses");
+        m_learned_import = lc.detach();
+    }
+
+    /**
+       \brief Add the clauses of m_learned_import. Atoms of the imported
+       clauses are matched with the Boolean variables of the context,
+       so this is done after the assertions have been internalized.
+    */
+    void context::add_imported_learned() {
+        SASSERT(m_scope_lvl == 0);
+        scoped_ptr<learned_clauses> lc = m_learned_import.detach();
+        auto const & atoms = lc->m_atoms;
+        u_map<unsigned> hash2atom;
+        unsigned_vector next(atoms.size(), UINT_MAX);        // atoms with the same hash
+        unsigned_vector atom2var(atoms.size(), null_bool_var);
+        for (unsigned i = 0; i < atoms.size(); ++i) {
+            unsigned j = UINT_MAX;
+            if (hash2atom.find(atoms[i].m_hash, j))
+                next[i] = j;
+            hash2atom.insert(atoms[i].m_hash, i);
+        }
+        unsigned num_atoms = 0;
+        std::string text;
+        for (bool_var v = true_bool_var + 1; v < static_cast<bool_var>(get_num_bool_vars()); ++v) {
+            expr * e = bool_var2expr(v);
+            unsigned i = UINT_MAX;
+            if (!hash2atom.find(e->hash(), i))
+                continue;
+            if (!atom_text(e, text))
+                continue;
+            for (; i != UINT_MAX; i = next[i]) {
+                if (atom2var[i] != null_bool_var || atoms[i].m_text != text)
+                    continue;
+                atom2var[i] = v;
+                ++num_atoms;
+                if (atoms[i].m_activity > 0) {
+                    set_activity(v, get_activity(v) + atoms[i].m_activity * m_bvar_inc);
+                    activity_changed(v, true);
+                }
+                if (atoms[i].m_phase != 0)
+                    force_phase(v, atoms[i].m_phase == 2);
+                break;
+            }
+        }
+        unsigned num_clauses = 0;
+        literal_vector lits;
+        for (unsigned_vector const & c : lc->m_clauses) {
+            if (inconsistent())
+                break;
+            lits.reset();
+            for (unsigned lit : c) {
+                bool_var v = atom2var[lit >> 1];
+                if (v == null_bool_var)
+                    break;
+                lits.push_back(literal(v, (lit & 1) != 0));
+            }
+            if (lits.size() < c.size())
+                continue;
+            ++num_clauses;
+            m_stats.m_num_imported_clauses++;
+            mk_clause(lits.size(), lits.data(), nullptr, CLS_TH_LEMMA);
+        }
+        IF_VERBOSE(2, verbose_stream() << "(smt.import-learned :atoms " << num_atoms << "/" << atoms.size()
+                   << " :clauses " << num_clauses << "/" << lc->m_clauses.size() << ")\n";);
+    }
+}
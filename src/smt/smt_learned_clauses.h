@@ -0,0 +1,59 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_learned_clauses.h
+
+Abstract:
+
+    Learned clauses, activities and phases of a context in a form
+    that can be saved to a file and loaded into a fresh context
+    over the same assertions.
+
+    Atoms are identified by their structural hash and their SMT-LIB
+    text, so that they can be matched in a different process. Only
+    atoms that are visible to the user are exported: atoms containing
+    skolem functions, bound variables or quantifiers, and atoms above
+    a size limit are skipped together with the clauses that use them.
+
+    The file consists of
+
+        magic "Z3LC", version byte
+        #atoms, followed for each atom by
+            hash (4 bytes), text length, text, activity (8 bytes), phase byte
+        #clauses, followed for each clause by
+            size, literals encoded as 2*atom + sign
+
+    where counts, lengths and literals are unsigned LEB128 integers
+    and fixed size fields are little endian. Phase bytes are 0 (no
+    saved phase), 1 (false) or 2 (true).
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include <string>
+#include <istream>
+#include <ostream>
+
+namespace smt {
+
+    struct learned_clauses {
+        struct atom {
+            unsigned    m_hash = 0;
+            std::string m_text;
+            double      m_activity = 0;  // relative to the largest exported activity
+            unsigned    m_phase = 0;
+        };
+        vector<atom>           m_atoms;
+        vector<unsigned_vector> m_clauses;
+
+        void write(std::ostream & out) const;
+
+        /**
+           \brief Read clauses written by write. Return false if the input is malformed.
+        */
+        bool read(std::istream & in);
+    };
+}
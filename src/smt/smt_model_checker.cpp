@@ -35,6 +35,9 @@ Revision History:
 #include "smt/smt_model_finder.h"
 #include "model/model_pp.h"
 #include <tuple>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace smt {
 
@@ -54,6 +57,7 @@ namespace smt {
     }
 
     model_checker::~model_checker() {
+        reset_workers();
         m_aux_context = nullptr; // delete aux context before fparams
         m_fparams = nullptr;
     }
@@ -140,29 +144,28 @@ namespace smt {
     }
 
     /**
-       \brief Assert in m_aux_context, the constraint
+       \brief Add to fmls the constraint
 
          sk = e_1 OR ... OR sk = e_n
 
          where {e_1, ..., e_n} is the universe.
      */
-    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe) {
+    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls) {
         SASSERT(!universe.empty());
         ptr_buffer<expr> eqs;
         for (expr * e : universe) {
             eqs.push_back(m.mk_eq(sk, e));
         }
-        expr_ref fml(m.mk_or(eqs), m);
-        m_aux_context->assert_expr(fml);
+        fmls.push_back(m.mk_or(eqs));
     }
 
     /**
-       \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
+       \brief Collect in fmls the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
 
        The variables are replaced by skolem constants. These constants are stored in sks.
     */
 
-    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+    bool model_checker::mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls) {
         expr_ref tmp(m);
         
         TRACE(model_checker, tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
@@ -181,7 +184,7 @@ namespace smt {
             sks[num_decls - i - 1]        = sk;
             subst_args[num_decls - i - 1] = sk;
             if (m_curr_model->is_finite(s)) {
-                restrict_to_universe(sk, m_curr_model->get_known_universe(s));
+                restrict_to_universe(sk, m_curr_model->get_known_universe(s), fmls);
             }
         }
 
@@ -190,7 +193,19 @@ namespace smt {
         expr_ref r(m);
         r = m.mk_not(sk_body);
         TRACE(model_checker, tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
-        m_aux_context->assert_expr(r);
+        fmls.push_back(r);
+        return true;
+    }
+
+    /**
+       \brief Assert in m_aux_context the formulas produced by mk_neg_q_m.
+    */
+    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+        expr_ref_vector fmls(m);
+        if (!mk_neg_q_m(q, sks, fmls))
+            return false;
+        for (expr * fml : fmls)
+            m_aux_context->assert_expr(fml);
         return true;
     }
 
@@ -298,8 +313,9 @@ namespace smt {
         return false;
     }
 
-    bool model_checker::add_blocking_clause(model * cex, expr_ref_vector & sks) {
+    bool model_checker::add_blocking_clause(context & ctx, model * cex, expr_ref_vector const & sks) {
         SASSERT(cex != nullptr);
+        ast_manager & m = ctx.get_manager();
         expr_ref_buffer diseqs(m);
         for (expr * sk : sks) {
             func_decl * sk_d = to_app(sk)->get_decl();
@@ -313,7 +329,7 @@ namespace smt {
         expr_ref blocking_clause(m);
         blocking_clause = m.mk_or(diseqs);
         TRACE(model_checker, tout << "blocking clause:\n" << mk_ismt2_pp(blocking_clause, m) << "\n";);
-        m_aux_context->assert_expr(blocking_clause);
+        ctx.assert_expr(blocking_clause);
         return true;
     }
 
@@ -377,7 +393,7 @@ namespace smt {
                 break;
             }
             num_new_instances++;
-            if (num_new_instances >= m_max_cexs || !add_blocking_clause(cex.get(), sks)) {
+            if (num_new_instances >= m_max_cexs || !add_blocking_clause(*m_aux_context, cex.get(), sks)) {
                 TRACE(model_checker, tout << "Add blocking clause failed new-instances: " << num_new_instances << " max-cex: " << m_max_cexs << "\n";);
                 // add_blocking_clause failed... stop the search for new counter-examples...
                 break;
@@ -393,6 +409,70 @@ namespace smt {
         return false;
     }
 
+    struct model_checker::mbqi_job {
+        quantifier *       m_q;
+        expr_ref_vector    m_sks;          // skolem constants of the flat quantifier
+        expr_ref_vector    m_fmls;         // negation of the quantifier under the current model
+        expr_ref_vector    m_restrictions; // restriction of the skolem constants to the instantiation sets
+        lbool              m_result = l_undef;
+        model_ref          m_complete_cex;
+        vector<model_ref>  m_cexs;
+        mbqi_job(ast_manager & m, quantifier * q): m_q(q), m_sks(m), m_fmls(m), m_restrictions(m) {}
+    };
+
+    /**
+       \brief Solve the model checking problem j in ctx.
+       It mirrors check(q): the complete check is followed by the search for
+       counter-examples restricted to the instantiation sets. The counter-examples
+       are only recorded, add_instances(j) turns them into instances.
+    */
+    void model_checker::solve(context & ctx, mbqi_job & j, unsigned max_cexs) {
+        SASSERT(!ctx.relevancy());
+        scoped_ctx_push _push(&ctx);
+        for (expr * fml : j.m_fmls)
+            ctx.assert_expr(fml);
+
+        flet<bool> l1(ctx.get_fparams().m_array_fake_support, true);
+        flet<bool> l2(ctx.get_fparams().m_preprocess, true);
+        j.m_result = ctx.check();
+        if (j.m_result != l_true)
+            return;
+        ctx.get_model(j.m_complete_cex);
+
+        for (expr * fml : j.m_restrictions)
+            ctx.assert_expr(fml);
+        while (j.m_cexs.size() < max_cexs && ctx.check() == l_true) {
+            model_ref cex;
+            ctx.get_model(cex);
+            j.m_cexs.push_back(cex);
+            if (!add_blocking_clause(ctx, cex.get(), j.m_sks))
+                break;
+        }
+    }
+
+    /**
+       \brief Create instances from the counter-examples of j.
+       Return true if j.m_q is satisfied by m_curr_model.
+    */
+    bool model_checker::add_instances(mbqi_job & j) {
+        quantifier * q = j.m_q;
+        TRACE(model_checker, tout << "[complete] model-checker result: " << to_sat_str(j.m_result) << "\n";);
+        if (j.m_result != l_true)
+            return is_safe_for_mbqi(q) && j.m_result == l_false;
+
+        unsigned num_new_instances = 0;
+        for (model_ref & cex : j.m_cexs) {
+            if (!add_instance(q, cex.get(), j.m_sks, true))
+                break;
+            num_new_instances++;
+        }
+        if (num_new_instances == 0) {
+            TRACE(model_checker, tout << "using complete_cex result:\n"; model_pp(tout, *j.m_complete_cex););
+            add_instance(q, j.m_complete_cex.get(), j.m_sks, false);
+        }
+        return false;
+    }
+
     bool model_checker::is_safe_for_mbqi(quantifier * q) const {
         special_relations_util sp(m);
         if (!sp.has_special_relation())
@@ -421,6 +501,7 @@ namespace smt {
             m_fparams->m_axioms2files = false;
             m_fparams->m_lemmas2console = false;
             m_fparams->m_proof_log = symbol::null;
+            m_fparams->m_qi_profile = false;
         }
         if (!m_aux_context) {
             symbol logic;
@@ -503,6 +584,12 @@ namespace smt {
     //
 
     void model_checker::check_quantifiers(bool& found_relevant, unsigned& num_failures) {
+#ifndef SINGLE_THREAD
+        if (m_params.m_mbqi_threads > 1) {
+            check_quantifiers_parallel(found_relevant, num_failures);
+            return;
+        }
+#endif
         for (quantifier * q : *m_qm) {
             if (!(m_qm->mbqi_enabled(q) &&
                   m_context->is_relevant(q) &&
@@ -530,6 +617,177 @@ namespace smt {
         }
     }
 
+#ifndef SINGLE_THREAD
+
+    /**
+       \brief A worker solves model checking problems in an ast_manager and auxiliary context of its own.
+       The main thread translates the problems to the worker and the counter-examples back,
+       so that the worker thread never touches the main ast_manager. Workers are kept across
+       rounds, so the auxiliary context is only set up once.
+    */
+    struct model_checker::mbqi_worker {
+        ast_manager                 m;
+        ast_translation             m_g2l, m_l2g;
+        smt_params                  m_fparams;
+        scoped_ptr<context>         m_ctx;
+        scoped_ptr_vector<mbqi_job> m_jobs;
+        unsigned_vector             m_ids;   // position of the jobs in the main thread
+        std::exception_ptr          m_exception;
+
+        mbqi_worker(ast_manager & g, smt_params const & p): m_g2l(g, m), m_l2g(m, g), m_fparams(p) {}
+
+        void begin_round(ast_manager & g) {
+            // the limit of the main thread is pushed to the worker for the round, pop restores it.
+            m.limit().push(0);
+            // fresh constants created by the worker should not collide with the skolem constants.
+            m.update_fresh_id(g);
+        }
+
+        // the translation caches hold expressions of the main manager that may be deleted before the next round.
+        void end_round() {
+            m_jobs.reset();
+            m_ids.reset();
+            m_g2l.reset_cache();
+            m_l2g.reset_cache();
+            m_exception = nullptr;
+            m.limit().pop();
+        }
+
+        void add(unsigned id, mbqi_job const & j) {
+            mbqi_job * lj = alloc(mbqi_job, m, nullptr);
+            for (expr * e : j.m_sks)
+                lj->m_sks.push_back(m_g2l(e));
+            for (expr * e : j.m_fmls)
+                lj->m_fmls.push_back(m_g2l(e));
+            for (expr * e : j.m_restrictions)
+                lj->m_restrictions.push_back(m_g2l(e));
+            m_jobs.push_back(lj);
+            m_ids.push_back(id);
+        }
+
+        void run(unsigned max_cexs) {
+            try {
+                for (mbqi_job * j : m_jobs)
+                    solve(*m_ctx, *j, max_cexs);
+            }
+            catch (...) {
+                m_exception = std::current_exception();
+            }
+        }
+
+        void collect(mbqi_job & j, mbqi_job const & lj) {
+            j.m_result = lj.m_result;
+            if (lj.m_complete_cex)
+                j.m_complete_cex = lj.m_complete_cex->translate(m_l2g);
+            for (model_ref const & cex : lj.m_cexs)
+                j.m_cexs.push_back(model_ref(cex->translate(m_l2g)));
+        }
+    };
+
+    void model_checker::reset_workers() {
+        for (mbqi_worker * w : m_workers)
+            dealloc(w);
+        m_workers.reset();
+    }
+
+    /**
+       \brief Model check the quantifiers using m_params.m_mbqi_threads workers.
+       The negated quantifiers and the instantiation set restrictions are built on the main thread,
+       the workers only run the auxiliary checks. Instances are then created in the order of
+       the quantifiers, so the result does not depend on the scheduling of the workers.
+    */
+    void model_checker::check_quantifiers_parallel(bool& found_relevant, unsigned& num_failures) {
+        scoped_ptr_vector<mbqi_job> jobs;
+        for (quantifier * q : *m_qm) {
+            if (!(m_qm->mbqi_enabled(q) &&
+                  m_context->is_relevant(q) &&
+                  m_context->get_assignment(q) == l_true)) {
+                if (!m_qm->mbqi_enabled(q))
+                    ++num_failures;
+                continue;
+            }
+            if (m_params.m_mbqi_trace && q->get_qid() != symbol::null) {
+                IF_VERBOSE(1, verbose_stream() << "(smt.mbqi :checking " << q->get_qid() << ")\n");
+            }
+            found_relevant = true;
+            mbqi_job * j = alloc(mbqi_job, m, q);
+            jobs.push_back(j);
+            quantifier * flat_q = get_flat_quantifier(q);
+            if (!mk_neg_q_m(flat_q, j->m_sks, j->m_fmls)) {
+                j->m_sks.reset(); // there is nothing to check, the job fails.
+                continue;
+            }
+            m_model_finder.get_sks_restrictions(q, j->m_sks, j->m_restrictions);
+        }
+
+        ptr_vector<mbqi_job> todo;
+        for (mbqi_job * j : jobs)
+            if (!j->m_sks.empty())
+                todo.push_back(j);
+
+        unsigned num_threads = std::min(m_params.m_mbqi_threads, todo.size());
+        if (num_threads <= 1) {
+            for (mbqi_job * j : todo)
+                solve(*m_aux_context, *j, m_max_cexs);
+        }
+        else {
+            while (m_workers.size() < num_threads) {
+                mbqi_worker * w = alloc(mbqi_worker, m, *m_fparams);
+                m_workers.push_back(w);
+                w->m_ctx = alloc(context, w->m, w->m_fparams, m_aux_context->get_params());
+                w->m_ctx->m_is_auxiliary = true;
+                w->m_ctx->set_logic(symbol());
+                w->m_ctx->copy_plugins(*m_context, *w->m_ctx);
+            }
+            for (unsigned i = 0; i < num_threads; ++i)
+                m_workers[i]->begin_round(m);
+            on_scope_exit _end_round([&]() {
+                for (unsigned i = 0; i < num_threads; ++i)
+                    m_workers[i]->end_round();
+            });
+            scoped_limits sl(m.limit());
+            for (unsigned i = 0; i < num_threads; ++i)
+                sl.push_child(&m_workers[i]->m.limit());
+            for (unsigned i = 0; i < todo.size(); ++i)
+                m_workers[i % num_threads]->add(i, *todo[i]);
+
+            unsigned max_cexs = m_max_cexs;
+            vector<std::thread> threads(num_threads);
+            for (unsigned i = 0; i < num_threads; ++i) {
+                mbqi_worker * w = m_workers[i];
+                threads[i] = std::thread([w, max_cexs]() { w->run(max_cexs); });
+            }
+            for (auto & th : threads)
+                th.join();
+
+            for (unsigned i = 0; i < num_threads; ++i) {
+                mbqi_worker * w = m_workers[i];
+                if (w->m_exception)
+                    std::rethrow_exception(w->m_exception);
+                for (unsigned k = 0; k < w->m_jobs.size(); ++k)
+                    w->collect(*todo[w->m_ids[k]], *w->m_jobs[k]);
+                m.update_fresh_id(w->m);
+            }
+        }
+
+        for (mbqi_job * j : jobs) {
+            quantifier * q = j->m_q;
+            if (j->m_sks.empty() || !add_instances(*j)) {
+                if (m_params.m_mbqi_trace || get_verbosity_level() >= 5) {
+                    IF_VERBOSE(0, verbose_stream() << "(smt.mbqi :failed " << q->get_qid() << ")\n");
+                }
+                TRACE(model_checker, tout << "checking quantifier " << mk_pp(q, m) << " failed\n";);
+                num_failures++;
+            }
+        }
+    }
+
+#else
+
+    void model_checker::reset_workers() {}
+
+#endif
+
     void model_checker::init_search_eh() {
         m_max_cexs = m_params.m_mbqi_max_cexs;
         m_iteration_idx = 0;
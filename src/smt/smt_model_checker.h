@@ -60,12 +60,22 @@ namespace smt {
         expr * get_term_from_ctx(expr * val);
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
-        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
+        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls);
+        bool mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls);
         bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
-        bool add_blocking_clause(model * cex, expr_ref_vector & sks);
+        static bool add_blocking_clause(context & ctx, model * cex, expr_ref_vector const & sks);
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
 
+        // model checking problem of a quantifier that is solved independently of the main context.
+        struct mbqi_job;
+        struct mbqi_worker;
+        ptr_vector<mbqi_worker>                     m_workers; // kept across rounds of model checking
+        static void solve(context & ctx, mbqi_job & j, unsigned max_cexs);
+        bool add_instances(mbqi_job & j);
+        void check_quantifiers_parallel(bool& found_relevant, unsigned& num_failures);
+        void reset_workers();
+
         struct instance {
             quantifier * m_q;
             unsigned     m_generation;
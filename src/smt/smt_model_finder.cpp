@@ -2649,20 +2649,17 @@ namespace smt {
     }
 
     /**
-       \brief Assert constraints restricting the possible values of the skolem constants can be assigned to.
+       \brief Collect constraints restricting the possible values of the skolem constants can be assigned to.
        The idea is to restrict them to the values in the instantiation sets.
 
        \remark q is the quantifier before flattening.
-
-       Return true if something was asserted.
     */
-    bool model_finder::restrict_sks_to_inst_set(context* aux_ctx, quantifier* q, expr_ref_vector const& sks) {
+    void model_finder::get_sks_restrictions(quantifier* q, expr_ref_vector const& sks, expr_ref_vector& fmls) {
         // Note: we currently add instances of q instead of flat_q.
         // If the user wants instances of flat_q, it should use PULL_NESTED_QUANTIFIERS=true. This option
         // will guarantee that q == flat_q.
         //
         // Since we only care about q (and its bindings), it only makes sense to restrict the variables of q.
-        bool asserted_something = false;
         unsigned num_decls = q->get_num_decls();
         // Remark: sks were created for the flat version of q.  
         SASSERT(get_flat_quantifier(q)->get_num_decls() == sks.size());
@@ -2688,18 +2685,25 @@ namespace smt {
                 }
             }
             if (!eqs.empty()) {
-                expr_ref new_cnstr(m);
-                new_cnstr = m.mk_or(eqs);
-                TRACE(model_finder, tout << "assert_restriction:\n" << mk_pp(new_cnstr, m) << "\n";);
-                aux_ctx->assert_expr(new_cnstr);
-                for (auto def : defs) {
-                    TRACE(model_finder, tout << "assert_def:\n" << mk_pp(def, m) << "\n";);
-                    aux_ctx->assert_expr(def);
-                }
-                asserted_something = true;
+                expr_ref new_cnstr(m.mk_or(eqs), m);
+                TRACE(model_finder, tout << "restriction:\n" << new_cnstr << "\ndefs:\n" << defs << "\n";);
+                fmls.push_back(new_cnstr);
+                fmls.append(defs);
             }
         }
-        return asserted_something;
+    }
+
+    /**
+       \brief Assert the constraints produced by get_sks_restrictions in aux_ctx.
+
+       Return true if something was asserted.
+    */
+    bool model_finder::restrict_sks_to_inst_set(context* aux_ctx, quantifier* q, expr_ref_vector const& sks) {
+        expr_ref_vector fmls(m);
+        get_sks_restrictions(q, sks, fmls);
+        for (expr* fml : fmls)
+            aux_ctx->assert_expr(fml);
+        return !fmls.empty();
     }
 
     void model_finder::restart_eh() {
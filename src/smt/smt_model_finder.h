@@ -115,6 +115,7 @@ namespace smt {
 
         quantifier * get_flat_quantifier(quantifier * q);
         expr * get_inv(quantifier * q, unsigned i, expr * val, model& m, unsigned & generation);
+        void get_sks_restrictions(quantifier * q, expr_ref_vector const & sks, expr_ref_vector & fmls);
         bool restrict_sks_to_inst_set(context * aux_ctx, quantifier * q, expr_ref_vector const & sks);
 
         void restart_eh();
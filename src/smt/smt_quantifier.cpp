@@ -304,6 +304,8 @@ namespace smt {
             
             get_stat(q)->update_max_generation(max_generation);
             fingerprint * f = m_context.add_fingerprint(q, q->get_id(), num_bindings, bindings);
+            if (qi_profiler * p = m_context.get_qi_profiler())
+                p->match_eh(q, pat, f != nullptr);
             if (f) {
                 if (is_trace_enabled(TraceTag::causality)) {
                     log_causality(f,pat,used_enodes);
@@ -777,6 +779,12 @@ namespace smt {
                 st.update("ho-matching refinements", m_stat_ho_refine);
                 st.update("ho-matching instances", m_stat_ho_instances);
             }
+            if (m_mam) {
+                mam_stats mst;
+                m_mam->add_statistics(mst);
+                m_lazy_mam->add_statistics(mst);
+                mst.collect_statistics(st);
+            }
             if (m_model_finder)
                 m_model_finder->collect_statistics(st);
         }
@@ -148,12 +148,15 @@ namespace smt {
         // obj_map pointer-hash probe for the common unwatched-literal case at the
         // assign_eh hotspot.
         uint_set                       m_is_watched[2];
+        // Gates whose argument watches are installed only while the gate is relevant.
+        obj_map<expr, relevancy_ehs *> m_lazy_watches;
         struct eh_trail {
-            enum class kind { POS_WATCH, NEG_WATCH, HANDLER };
+            enum class kind { POS_WATCH, NEG_WATCH, HANDLER, LAZY_WATCH };
             kind   m_kind;
             expr * m_node;
             eh_trail(expr * n):m_kind(kind::HANDLER), m_node(n) {}
             eh_trail(expr * n, bool val):m_kind(val ? kind::POS_WATCH : kind::NEG_WATCH), m_node(n) {}
+            eh_trail(kind k, expr * n):m_kind(k), m_node(n) {}
             kind get_kind() const { return m_kind; }
             expr * get_node() const { return m_node; }
         };
@@ -164,6 +167,13 @@ namespace smt {
         };
         svector<scope>                 m_scopes;
         bool                           m_propagating = false;
+        struct stats {
+            unsigned m_num_relevant = 0;    // expressions marked as relevant
+            unsigned m_num_eh = 0;          // event handlers invoked
+            unsigned m_num_watches = 0;     // watches installed
+            unsigned m_num_lazy_watches = 0; // watches installed for relevant gates
+        };
+        stats                          m_stats;
 
         relevancy_propagator_imp(context & ctx):
             relevancy_propagator(ctx), m_relevant_exprs(ctx.get_manager()) {}
@@ -211,6 +221,19 @@ namespace smt {
             }
         }
 
+        relevancy_ehs * get_lazy_watches(expr * n) {
+            relevancy_ehs * r = nullptr;
+            m_lazy_watches.find(n, r);
+            return r;
+        }
+
+        void set_lazy_watches(expr * n, relevancy_ehs * ehs) {
+            if (ehs == nullptr)
+                m_lazy_watches.erase(n);
+            else
+                m_lazy_watches.insert(n, ehs);
+        }
+
         void push_trail(eh_trail const & t) {
             get_manager().inc_ref(t.get_node());
             m_trail.push_back(t);
@@ -242,13 +265,64 @@ namespace smt {
                 SASSERT(eh);
                 set_watches(n, val, new (get_region()) relevancy_ehs(eh, get_watches(n, val)));
                 push_trail(eh_trail(n, val));
+                m_stats.m_num_watches++;
                 break;
             case l_true:
+                m_stats.m_num_eh++;
                 eh->operator()(*this, n, val);
                 break;
             }
         }
 
+        void add_lazy_watches(app * n, relevancy_eh * eh) override {
+            if (!enabled())
+                return;
+            if (is_relevant_core(n)) {
+                watch_args(n, eh);
+            }
+            else {
+                push_trail(eh_trail(eh_trail::kind::LAZY_WATCH, n));
+                set_lazy_watches(n, new (get_region()) relevancy_ehs(eh, get_lazy_watches(n)));
+            }
+        }
+
+        /**
+           \brief Watch the arguments of the relevant gate n.
+
+           Only unassigned arguments are watched. Arguments that are already assigned
+           are processed when n is taken from the queue of relevant expressions, and they
+           stay assigned for as long as the watches and the relevancy of n exist.
+        */
+        void watch_args(app * n, relevancy_eh * eh) {
+            ast_manager & m = get_manager();
+            auto watch = [&](expr * arg, bool val) {
+                literal l = m_context.get_literal(arg);
+                if (!val)
+                    l.neg();
+                if (m_context.get_assignment(l) != l_undef)
+                    return;
+                expr * a = m_context.bool_var2expr(l.var());
+                set_watches(a, !l.sign(), new (get_region()) relevancy_ehs(eh, get_watches(a, !l.sign())));
+                push_trail(eh_trail(a, !l.sign()));
+                m_stats.m_num_lazy_watches++;
+            };
+            if (m.is_and(n)) {
+                for (expr * arg : *n)
+                    watch(arg, false);
+            }
+            else if (m.is_or(n)) {
+                for (expr * arg : *n)
+                    watch(arg, true);
+            }
+            else if (m.is_implies(n)) {
+                watch(n->get_arg(0), false);
+                watch(n->get_arg(1), true);
+            }
+            else {
+                UNREACHABLE();
+            }
+        }
+
         void add_watch(expr * n, bool val, expr * target) override {
             if (!enabled())
                 return;
@@ -320,6 +394,7 @@ namespace smt {
                 case eh_trail::kind::POS_WATCH: ehs = get_watches(n, true); SASSERT(ehs); set_watches(n, true, ehs->tail()); break;
                 case eh_trail::kind::NEG_WATCH: ehs = get_watches(n, false); SASSERT(ehs); set_watches(n, false, ehs->tail()); break;
                 case eh_trail::kind::HANDLER:   ehs = get_handlers(n); SASSERT(ehs); set_handlers(n, ehs->tail()); break;
+                case eh_trail::kind::LAZY_WATCH: ehs = get_lazy_watches(n); SASSERT(ehs); set_lazy_watches(n, ehs->tail()); break;
                 default: UNREACHABLE(); break;
                 }
                 m.dec_ref(n);
@@ -330,6 +405,11 @@ namespace smt {
         void set_relevant(expr * n) {
             m_is_relevant.insert(n->get_id());
             m_relevant_exprs.push_back(n);
+            m_stats.m_num_relevant++;
+            if (!m_lazy_watches.empty()) {
+                for (relevancy_ehs * ehs = get_lazy_watches(n); ehs; ehs = ehs->tail())
+                    watch_args(to_app(n), ehs->head());
+            }
             m_context.relevant_eh(n);
         }
 
@@ -542,6 +622,7 @@ namespace smt {
                 
                 relevancy_ehs * ehs = get_handlers(n);
                 while (ehs != nullptr) {
+                    m_stats.m_num_eh++;
                     ehs->head()->operator()(*this, n);
                     ehs = ehs->tail();
                 }
@@ -567,6 +648,7 @@ namespace smt {
             }
             relevancy_ehs * ehs = get_watches(n, val);
             while (ehs != nullptr) {
+                m_stats.m_num_eh++;
                 ehs->head()->operator()(*this, n, val);
                 ehs = ehs->tail();
             }
@@ -582,6 +664,17 @@ namespace smt {
             }
         }
 
+        void collect_statistics(::statistics & st, unsigned num_conflicts) const override {
+            if (!enabled())
+                return;
+            st.update("relevancy propagations", m_stats.m_num_relevant);
+            st.update("relevancy eh", m_stats.m_num_eh);
+            st.update("relevancy watches", m_stats.m_num_watches);
+            st.update("relevancy lazy watches", m_stats.m_num_lazy_watches);
+            if (num_conflicts > 0)
+                st.update("relevancy propagations per conflict", static_cast<double>(m_stats.m_num_relevant) / num_conflicts);
+        }
+
 #ifdef Z3DEBUG
         bool check_relevancy_app(app * n) const  {
             SASSERT(is_relevant(n));
@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "ast/ast.h"
+#include "util/statistics.h"
 
 namespace smt {
     class context;
@@ -111,6 +112,15 @@ namespace smt {
         */
         virtual void add_watch(expr * n, bool val, expr * target) = 0;
 
+        /**
+           \brief Install the watches of the Boolean gate n (and, or, implies) when n is marked as relevant.
+
+           The event handler eh is attached to the arguments of n whose assignment may justify
+           the relevancy of n, but only while n is relevant. Gates that never become relevant
+           do not pay for watches, and watches of a gate are removed when its relevancy is retracted.
+        */
+        virtual void add_lazy_watches(app * n, relevancy_eh * eh) = 0;
+
         /**
            \brief smt::context invokes this method whenever the expression is assigned to true/false
         */
@@ -153,6 +163,11 @@ namespace smt {
         */
         virtual void display(std::ostream & out) const = 0;
 
+        /**
+           \brief Collect statistics, the number of conflicts is used to report propagations per conflict.
+        */
+        virtual void collect_statistics(::statistics & st, unsigned num_conflicts) const = 0;
+
 #ifdef Z3DEBUG
         virtual bool check_relevancy(expr_ref_vector const & v) const = 0;
         virtual bool check_relevancy_or(app * n, bool root) const = 0;
@@ -219,6 +219,14 @@ namespace {
             return m_context.get_trail(max_level);
         }
 
+        void export_learned(std::ostream& out) override {
+            m_context.export_learned(out);
+        }
+
+        void import_learned(std::istream& in) override {
+            m_context.import_learned(in);
+        }
+
         expr_ref_vector get_assigned_literals() override {
             expr_ref_vector result(m);
             auto const& ctx = m_context.get_context();
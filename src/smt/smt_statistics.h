@@ -42,10 +42,12 @@ namespace smt {
         unsigned m_num_interface_eqs;
         unsigned m_max_generation;
         unsigned m_num_minimized_lits;
+        unsigned m_num_minimize_cache_hits;
         unsigned m_num_checks;
         unsigned m_num_simplifications;
         unsigned m_num_del_clauses;
         unsigned m_num_assignments;
+        unsigned m_num_imported_clauses;
         statistics() {
             reset();
         }
@@ -324,6 +324,16 @@ public:
             return m_solver2->get_trail(max_level);
     }
 
+    // learned clauses live in the incremental solver.
+    void export_learned(std::ostream& out) override {
+        m_solver2->export_learned(out);
+    }
+
+    void import_learned(std::istream& in) override {
+        switch_inc_mode();
+        m_solver2->import_learned(in);
+    }
+
     proof * get_proof_core() override {
         if (m_use_solver1_results)
             return m_solver1->get_proof_core();
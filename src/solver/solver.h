@@ -336,6 +336,16 @@ public:
 
     virtual void get_backbone_candidates(vector<scored_literal>&, unsigned) {}
 
+    /**
+       \brief Save learned clauses, so that they can be loaded into a fresh solver with the same assertions.
+    */
+    virtual void export_learned(std::ostream& out) { throw default_exception("solver does not support exporting learned clauses"); }
+
+    /**
+       \brief Load learned clauses saved by export_learned.
+    */
+    virtual void import_learned(std::istream& in) { throw default_exception("solver does not support importing learned clauses"); }
+
     class scoped_push {
         solver& s;
         bool    m_nopop;
@@ -0,0 +1,107 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    dimacs.cpp
+
+Abstract:
+
+    Parse DIMACS files in small chunks and compare with the stream parser:
+    clauses that span chunk boundaries, comments inside a clause that is
+    continued in the next chunk, and an unterminated last clause.
+
+--*/
+
+#include "sat/dimacs.h"
+#include "sat/sat_solver.h"
+#include "util/rlimit.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static char const * g_file = "tst_dimacs.cnf";
+
+/**
+   \brief Parse text with the stream parser, and from a file in chunks of chunk_size bytes.
+   Check that both parsers agree, return the result of the parsers.
+*/
+static bool parse(std::string const & text, size_t chunk_size) {
+    params_ref p;
+    reslimit rlim1, rlim2;
+    sat::solver s1(p, rlim1), s2(p, rlim2);
+    std::istringstream in(text);
+    std::ostringstream err1, err2;
+    bool ok1 = parse_dimacs(in, err1, s1);
+    {
+        std::ofstream out(g_file, std::ios::binary);
+        out << text;
+    }
+    bool ok2;
+    {
+        dimacs::mapped_file f(g_file);
+        ENSURE(f.ok());
+        ok2 = parse_dimacs(f, err2, s2, chunk_size);
+    }
+    std::remove(g_file);
+    ENSURE(ok1 == ok2);
+    std::ostringstream d1, d2;
+    s1.display_dimacs(d1);
+    s2.display_dimacs(d2);
+    ENSURE(d1.str() == d2.str());
+    return ok2;
+}
+
+// random clauses whose literals are spread over several lines
+static void tst_spanning_clauses() {
+    random_gen r(0);
+    std::ostringstream text;
+    text << "c random clauses\np cnf 20 200\n";
+    for (unsigned i = 0; i < 200; ++i) {
+        unsigned n = 1 + r(6);
+        for (unsigned j = 0; j < n; ++j) {
+            text << (r(2) == 0 ? "-" : "") << 1 + r(20) << (r(3) == 0 ? "\n" : " ");
+        }
+        text << "0\n";
+        if (r(10) == 0)
+            text << "c between clauses\n";
+    }
+    for (size_t chunk_size : { 1, 3, 7, 64, 1 << 24 })
+        ENSURE(parse(text.str(), chunk_size));
+}
+
+static void tst_comment_in_clause() {
+    std::string text = "p cnf 3 2\n1 2 0\n1 2\nc inside a clause\n3 0\n";
+    for (size_t chunk_size : { 1, 4, 1 << 24 })
+        ENSURE(!parse(text, chunk_size));
+}
+
+static void tst_unterminated_clause() {
+    std::string text = "p cnf 4 2\n1 2 0\n3\n4";
+    for (size_t chunk_size : { 1, 4, 1 << 24 }) {
+        params_ref p;
+        reslimit rlim;
+        sat::solver s(p, rlim);
+        {
+            std::ofstream out(g_file, std::ios::binary);
+            out << text;
+        }
+        std::ostringstream err;
+        {
+            dimacs::mapped_file f(g_file);
+            ENSURE(!parse_dimacs(f, err, s, chunk_size));
+        }
+        std::remove(g_file);
+        ENSURE(s.num_clauses() == 1);
+    }
+}
+
+void tst_dimacs() {
+    tst_spanning_clauses();
+    tst_comment_in_clause();
+    tst_unterminated_clause();
+}
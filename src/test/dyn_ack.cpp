@@ -0,0 +1,92 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    dyn_ack.cpp
+
+Abstract:
+
+    Garbage collection of the dynamic ackermannization tables
+    when they are filled past the cap on the number of entries.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "smt/dyn_ack.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <iostream>
+
+// fill the table with the pairs (f(a_0), f(a_i)) for i = 1 .. n, the pair for i occurs i times.
+static void fill(ast_manager & m, smt::dyn_ack_table<2> & table, app_ref_vector & apps, unsigned n) {
+    sort * s = m.mk_uninterpreted_sort(symbol("S"));
+    func_decl * f = m.mk_func_decl(symbol("f"), s, s);
+    for (unsigned i = 0; i <= n; ++i)
+        apps.push_back(m.mk_app(f, m.mk_const(symbol(("a" + std::to_string(i)).c_str()), s)));
+    for (unsigned i = 1; i <= n; ++i) {
+        expr * args[2] = { apps.get(0), apps.get(i) };
+        unsigned idx = table.insert(args);
+        table[idx].m_num_occs = i;
+    }
+}
+
+static unsigned decay(dyn_ack_params const & p, unsigned num_occs) {
+    return static_cast<unsigned>(num_occs * p.m_dack_gc_inv_decay);
+}
+
+// the table stays below the cap, gc only ages the counters.
+static void tst_aging() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    dyn_ack_params p;
+    smt::dyn_ack_table<2> table(m);
+    app_ref_vector apps(m);
+    unsigned n = 20;
+    fill(m, table, apps, n);
+    unsigned_vector to_instantiate;
+    smt::gc_table(m, p, table, 100, to_instantiate);
+    unsigned num_kept = 0, num_candidates = 0;
+    for (unsigned i = 1; i <= n; ++i) {
+        expr * args[2] = { apps.get(0), apps.get(i) };
+        unsigned num_occs = decay(p, i);
+        ENSURE(table.get_num_occs(args) == (num_occs <= 1 ? 0 : num_occs));
+        num_kept += num_occs > 1;
+        num_candidates += num_occs >= p.m_dack_threshold;
+    }
+    ENSURE(table.size() == num_kept);
+    ENSURE(to_instantiate.size() == num_candidates);
+}
+
+// the table is past the cap, gc ages the counters and keeps the half of
+// the cap with the most occurrences, the candidates come most frequent first.
+static void tst_cap() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    dyn_ack_params p;
+    smt::dyn_ack_table<2> table(m);
+    app_ref_vector apps(m);
+    unsigned n = 100, max_entries = 16;
+    fill(m, table, apps, n);
+    unsigned_vector to_instantiate;
+    smt::gc_table(m, p, table, max_entries, to_instantiate);
+    std::cout << "entries: " << n << " -> " << table.size() << " candidates: " << to_instantiate.size() << "\n";
+    ENSURE(table.size() == max_entries / 2);
+    for (unsigned i = 1; i <= n; ++i) {
+        expr * args[2] = { apps.get(0), apps.get(i) };
+        ENSURE(table.get_num_occs(args) == (i > n - max_entries / 2 ? decay(p, i) : 0));
+    }
+    ENSURE(to_instantiate.size() == max_entries / 2);
+    for (unsigned i = 0; i < to_instantiate.size(); ++i)
+        ENSURE(table[to_instantiate[i]].m_num_occs == decay(p, n - i));
+    // the table can be filled again after the shrink
+    expr * args[2] = { apps.get(1), apps.get(2) };
+    ENSURE(table.find(args) == UINT_MAX);
+    unsigned idx = table.insert(args);
+    ENSURE(table.find(args) == idx && table.size() == max_entries / 2 + 1);
+}
+
+void tst_dyn_ack() {
+    tst_aging();
+    tst_cap();
+}
@@ -0,0 +1,131 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    lp_bprop_batch.cpp
+
+Abstract:
+
+    Bound propagation on the touched rows of lar_solver finds the same
+    implied bounds, with the same explanations, when the rows are
+    analyzed on several threads (lp.bprop_threads > 1) as when they
+    are analyzed on the search thread.
+
+--*/
+
+#include "math/lp/lar_solver.h"
+#include "math/lp/lp_bound_propagator.h"
+#include "util/params.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // the part of the theory solver that bound propagation calls back into
+    class bprop_imp {
+        lp::lar_solver & m_lar;
+    public:
+        unsigned_vector m_consumed;
+        bprop_imp(lp::lar_solver & lar): m_lar(lar) {}
+        lp::lar_solver & lp() { return m_lar; }
+        lp::lar_solver const & lp() const { return m_lar; }
+        bool bound_is_interesting(unsigned, lp::lconstraint_kind, rational const &) const { return true; }
+        void consume(rational const &, lp::constraint_index ci) { m_consumed.push_back(ci); }
+        bool is_equal(unsigned, unsigned) const { return false; }
+        bool add_eq(lp::lpvar, lp::lpvar, lp::explanation const &, bool) { return false; }
+    };
+
+    struct bound_info {
+        lp::lpvar       m_j;
+        rational        m_bound;
+        bool            m_is_lower;
+        bool            m_strict;
+        unsigned_vector m_explanation;
+        bool operator==(bound_info const & other) const {
+            return m_j == other.m_j && m_bound == other.m_bound && m_is_lower == other.m_is_lower &&
+                m_strict == other.m_strict && m_explanation == other.m_explanation;
+        }
+    };
+}
+
+/**
+   \brief Variables have random bounds on some sides, the rows are terms over
+   three variables with bounds on the terms. The problem is not necessarily feasible,
+   the bounds are propagated from the current assignment either way.
+*/
+static void mk_problem(random_gen & r, lp::lar_solver & s, unsigned num_vars, unsigned num_rows) {
+    for (unsigned v = 0; v < num_vars; ++v) {
+        s.add_var(v, r(2) == 0);
+        if (r(3) != 0)
+            s.add_var_bound(v, lp::GE, rational(-static_cast<int>(r(20))));
+        if (r(3) != 0)
+            s.add_var_bound(v, lp::LE, rational(static_cast<int>(r(20))));
+    }
+    for (unsigned k = 0; k < num_rows; ++k) {
+        vector<std::pair<rational, lp::lpvar>> coeffs;
+        unsigned_vector vars;
+        while (vars.size() < 3) {
+            unsigned v = r(num_vars);
+            if (!vars.contains(v))
+                vars.push_back(v);
+        }
+        for (unsigned v : vars) {
+            int c = static_cast<int>(r(9)) - 4;
+            coeffs.push_back({ rational(c == 0 ? 1 : c), v });
+        }
+        lp::lpvar t = s.add_term(coeffs, num_vars + k);
+        s.add_var_bound(t, r(2) == 0 ? lp::GE : lp::LE, rational(static_cast<int>(r(41)) - 20));
+    }
+}
+
+/**
+   \brief Propagate the bounds of all rows of s on the given number of threads.
+*/
+static void propagate(lp::lar_solver & s, unsigned num_threads, vector<bound_info> & result) {
+    params_ref p;
+    p.set_uint("bprop_threads", num_threads);
+    p.set_uint("bprop_batch_min_rows", 1);
+    // only bounds are compared, equalities are propagated on the search thread in both cases
+    p.set_bool("arith.propagate_eqs", false);
+    s.settings().updt_params(p);
+    for (unsigned i = 0; i < s.A_r().row_count(); ++i)
+        s.touched_rows().insert(i);
+    bprop_imp imp(s);
+    std_vector<lp::implied_bound> ibounds;
+    lp::lp_bound_propagator<bprop_imp> bp(imp, ibounds);
+    s.propagate_bounds_for_touched_rows(bp);
+    ENSURE(s.touched_rows().empty());
+    result.reset();
+    for (auto const & ib : ibounds) {
+        imp.m_consumed.reset();
+        s.explain_implied_bound(ib, bp);
+        std::sort(imp.m_consumed.begin(), imp.m_consumed.end());
+        result.push_back({ ib.m_j, ib.m_bound, ib.m_is_lower_bound, ib.m_strict, imp.m_consumed });
+    }
+}
+
+void tst_lp_bprop_batch() {
+    random_gen r(0);
+    unsigned num_bounds = 0, num_batches = 0;
+    for (unsigned i = 0; i < 100; ++i) {
+        lp::lar_solver s;
+        unsigned num_vars = 5 + r(20);
+        mk_problem(r, s, num_vars, 2 + r(2 * num_vars));
+        s.find_feasible_solution();
+        vector<bound_info> sequential, batch2, batch4;
+        propagate(s, 1, sequential);
+        ENSURE(s.settings().stats().m_bprop_batches == 0);
+        propagate(s, 2, batch2);
+        propagate(s, 4, batch4);
+        ENSURE(sequential.size() == batch2.size() && sequential.size() == batch4.size());
+        for (unsigned k = 0; k < sequential.size(); ++k)
+            ENSURE(sequential[k] == batch2[k] && sequential[k] == batch4[k]);
+        num_bounds += sequential.size();
+        num_batches += s.settings().stats().m_bprop_batches;
+    }
+    std::cout << "implied bounds: " << num_bounds << " batches: " << num_batches << "\n";
+    ENSURE(num_bounds > 0);
+    ENSURE(num_batches == 200);
+}
@@ -0,0 +1,156 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    lp_fp_simplex.cpp
+
+Abstract:
+
+    Compare the feasibility check of lar_solver with and without
+    the floating point simplex stage on random bounded problems,
+    and check a problem where the floating point basis is rejected.
+
+--*/
+
+#include "math/lp/lar_solver.h"
+#include "util/params.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+    struct lp_row {
+        vector<std::pair<rational, lp::lpvar>> m_coeffs;
+        lp::lconstraint_kind                   m_kind;
+        rational                               m_bound;
+    };
+}
+
+static void mk_problem(random_gen & r, unsigned num_vars, unsigned num_rows, vector<lp_row> & rows) {
+    rows.reset();
+    for (unsigned k = 0; k < num_rows; ++k) {
+        lp_row row;
+        unsigned_vector vars;
+        while (vars.size() < 3) {
+            unsigned v = r(num_vars);
+            if (!vars.contains(v))
+                vars.push_back(v);
+        }
+        for (unsigned v : vars) {
+            int c = static_cast<int>(r(10)) - 5;
+            row.m_coeffs.push_back({ rational(c >= 0 ? c + 1 : c), v });
+        }
+        row.m_kind = r(2) == 0 ? lp::GE : lp::LE;
+        row.m_bound = rational(static_cast<int>(r(61)) - 30);
+        rows.push_back(row);
+    }
+}
+
+static bool is_feasible(lp::lp_status st) {
+    return st == lp::lp_status::OPTIMAL || st == lp::lp_status::FEASIBLE;
+}
+
+static void set_fp_params(lp::lar_solver & s) {
+    params_ref p;
+    p.set_bool("fp_simplex", true);
+    p.set_uint("fp_simplex_min_rows", 1);
+    p.set_uint("fp_simplex_min_infeasible", 1);
+    s.settings().updt_params(p);
+}
+
+/**
+   \brief Solve the problem where every variable is in [-10, 10] and the rows are
+   bounds on terms. Check that a model satisfies every constraint exactly.
+*/
+static lp::lp_status solve(bool fp_simplex, unsigned num_vars, vector<lp_row> const & rows, lp::statistics & fp_stats) {
+    lp::lar_solver s;
+    if (fp_simplex)
+        set_fp_params(s);
+    for (unsigned v = 0; v < num_vars; ++v) {
+        s.add_var(v, false);
+        s.add_var_bound(v, lp::GE, rational(-10));
+        s.add_var_bound(v, lp::LE, rational(10));
+    }
+    for (unsigned k = 0; k < rows.size(); ++k) {
+        lp::lpvar t = s.add_term(rows[k].m_coeffs, num_vars + k);
+        s.add_var_bound(t, rows[k].m_kind, rows[k].m_bound);
+    }
+    lp::lp_status st = s.find_feasible_solution();
+    auto const & stats = s.settings().stats();
+    fp_stats.m_fp_simplex_calls += stats.m_fp_simplex_calls;
+    fp_stats.m_fp_simplex_certified += stats.m_fp_simplex_certified;
+    fp_stats.m_fp_simplex_failures += stats.m_fp_simplex_failures;
+    if (!is_feasible(st))
+        return st;
+    std::unordered_map<lp::lpvar, rational> model;
+    s.get_model(model);
+    for (unsigned v = 0; v < num_vars; ++v)
+        ENSURE(rational(-10) <= model[v] && model[v] <= rational(10));
+    for (lp_row const & row : rows) {
+        rational val(0);
+        for (auto const & [c, v] : row.m_coeffs)
+            val += c * model[v];
+        ENSURE(row.m_kind == lp::GE ? val >= row.m_bound : val <= row.m_bound);
+    }
+    return st;
+}
+
+/**
+   \brief x - y >= 10^-12 holds within the floating point tolerance at x = y = 0,
+   so the basis found in floating point numbers is not feasible in rationals.
+   The rational simplex repairs it, and the next solve skips the stage.
+*/
+static void tst_rejected() {
+    lp::lar_solver s;
+    set_fp_params(s);
+    for (unsigned v = 0; v < 2; ++v) {
+        s.add_var(v, false);
+        s.add_var_bound(v, lp::GE, rational(0));
+        s.add_var_bound(v, lp::LE, rational(10));
+    }
+    vector<std::pair<rational, lp::lpvar>> coeffs;
+    coeffs.push_back({ rational(1), 0 });
+    coeffs.push_back({ rational(-1), 1 });
+    lp::lpvar t = s.add_term(coeffs, 2);
+    rational eps = rational(1) / rational(1000000000000ull, rational::ui64());
+    s.add_var_bound(t, lp::GE, eps);
+    ENSURE(is_feasible(s.find_feasible_solution()));
+    auto const & st = s.settings().stats();
+    std::cout << "fp simplex calls: " << st.m_fp_simplex_calls << " failures: " << st.m_fp_simplex_failures
+              << " certified: " << st.m_fp_simplex_certified << "\n";
+    ENSURE(st.m_fp_simplex_calls == 1 && st.m_fp_simplex_failures == 0 && st.m_fp_simplex_certified == 0);
+    std::unordered_map<lp::lpvar, rational> model;
+    s.get_model(model);
+    ENSURE(model[0] - model[1] >= eps);
+    s.add_var_bound(t, lp::GE, rational(2));
+    ENSURE(is_feasible(s.find_feasible_solution()));
+    ENSURE(st.m_fp_simplex_calls == 1);
+}
+
+void tst_lp_fp_simplex() {
+    tst_rejected();
+    random_gen r(0);
+    vector<lp_row> rows;
+    unsigned num_sat = 0, num_unsat = 0;
+    lp::statistics fp_stats;
+    for (unsigned i = 0; i < 300; ++i) {
+        unsigned num_vars = 4 + r(8);
+        unsigned num_rows = 2 + r(2 * num_vars);
+        mk_problem(r, num_vars, num_rows, rows);
+        lp::statistics off_stats;
+        lp::lp_status st_off = solve(false, num_vars, rows, off_stats);
+        lp::lp_status st_on = solve(true, num_vars, rows, fp_stats);
+        ENSURE(off_stats.m_fp_simplex_calls == 0);
+        ENSURE(is_feasible(st_off) == is_feasible(st_on));
+        if (is_feasible(st_on))
+            ++num_sat;
+        else
+            ++num_unsat;
+    }
+    std::cout << "sat: " << num_sat << " unsat: " << num_unsat
+              << " fp simplex calls: " << fp_stats.m_fp_simplex_calls
+              << " certified: " << fp_stats.m_fp_simplex_certified << "\n";
+    ENSURE(fp_stats.m_fp_simplex_certified > 0);
+}
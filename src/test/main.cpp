@@ -118,6 +118,7 @@
     X(seq_rewriter) \
     X(check_assumptions) \
     X(smt_context) \
+    X(smt_learned_clauses) \
     X(theory_dl) \
     X(model_retrieval) \
     X(model_based_opt) \
@@ -173,6 +174,17 @@
     X(theory_pb) \
     X(simplex) \
     X(sat_user_scope) \
+    X(sat_clause_allocator) \
+    X(sat_bva) \
+    X(dyn_ack) \
+    X(smt_minimize_lemma) \
+    X(smt_relevancy) \
+    X(smt_mbqi) \
+    X(lp_bprop_batch) \
+    X(dimacs) \
+    X(lp_fp_simplex) \
+    X(qi_instance_cache) \
+    X(nla_grobner) \
     X_ARGV(ddnf) \
     X(ddnf1) \
     X(model_evaluator) \
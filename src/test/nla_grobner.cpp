@@ -0,0 +1,164 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    nla_grobner.cpp
+
+Abstract:
+
+    Push and pop with the incremental Groebner basis of the nla solver.
+    Random nonlinear problems are checked in nested scopes with
+    arith.nl.grobner_incremental off, on, and toggled between the checks.
+    The scopes introduce new terms and bounds, so pop retracts equations
+    that use popped columns and equations with popped dependencies.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/statistics.h"
+#include "util/rlimit.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <cstring>
+#include <iostream>
+
+static unsigned get_uint_stat(smt::kernel const & s, char const * key) {
+    statistics st;
+    s.collect_statistics(st);
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0 && st.is_uint(i))
+            r = st.get_uint_value(i);
+    return r;
+}
+
+namespace {
+    class nla_scopes {
+        ast_manager &   m;
+        arith_util      a;
+        random_gen      m_rand;
+        expr_ref_vector m_vars;
+        expr_ref_vector m_monics;
+
+        expr_ref mk_num(int n) { return expr_ref(a.mk_real(n), m); }
+
+        int rand_coeff() { return static_cast<int>(m_rand(7)) - 3; }
+
+        // a linear combination of the variables and the monics
+        expr_ref mk_sum() {
+            expr_ref_vector args(m);
+            for (expr * v : m_vars)
+                if (m_rand(2) == 0)
+                    args.push_back(a.mk_mul(mk_num(rand_coeff()), v));
+            for (expr * v : m_monics)
+                if (m_rand(2) == 0)
+                    args.push_back(a.mk_mul(mk_num(rand_coeff()), v));
+            if (args.empty())
+                args.push_back(m_monics.get(m_rand(m_monics.size())));
+            return expr_ref(a.mk_add(args.size(), args.data()), m);
+        }
+
+        expr_ref mk_constraint() {
+            expr_ref s = mk_sum();
+            expr_ref k = mk_num(static_cast<int>(m_rand(11)) - 5);
+            switch (m_rand(3)) {
+            case 0: return expr_ref(m.mk_eq(s, k), m);
+            case 1: return expr_ref(a.mk_le(s, k), m);
+            default: return expr_ref(a.mk_ge(s, k), m);
+            }
+        }
+
+        void assert_scope(smt::kernel & s) {
+            unsigned n = 1 + m_rand(3);
+            for (unsigned i = 0; i < n; ++i)
+                s.assert_expr(mk_constraint());
+            expr * x = m_vars.get(m_rand(m_vars.size()));
+            s.assert_expr(a.mk_le(x, mk_num(static_cast<int>(m_rand(4)))));
+            s.assert_expr(a.mk_ge(x, mk_num(-static_cast<int>(m_rand(4)))));
+        }
+
+    public:
+        nla_scopes(ast_manager & m, unsigned seed):
+            m(m), a(m), m_rand(seed), m_vars(m), m_monics(m) {
+            for (unsigned i = 0; i < 4; ++i)
+                m_vars.push_back(m.mk_const(symbol(("x" + std::to_string(i)).c_str()), a.mk_real()));
+            for (unsigned i = 0; i < 4; ++i) {
+                expr * x = m_vars.get(m_rand(m_vars.size()));
+                expr * y = m_vars.get(m_rand(m_vars.size()));
+                m_monics.push_back(a.mk_mul(x, y));
+            }
+        }
+
+        /**
+           \brief Check the scopes of the problem, toggle flips arith.nl.grobner_incremental
+           before every check. Return the results of the checks.
+        */
+        svector<lbool> run(bool incremental, bool toggle, unsigned & retracted) {
+            smt_params fp;
+            params_ref p;
+            p.set_bool("arith.nl.grobner_incremental", incremental);
+            p.set_uint("arith.nl.grobner_frequency", 1);
+            smt::kernel s(m, fp, p);
+            svector<lbool> result;
+            auto check = [&]() {
+                if (toggle) {
+                    incremental = !incremental;
+                    params_ref q;
+                    q.set_bool("arith.nl.grobner_incremental", incremental);
+                    s.updt_params(q);
+                }
+                // nlsat can take long on some of the problems, those checks are skipped
+                scoped_rlimit _rl(m.limit(), 100000);
+                result.push_back(s.check());
+            };
+            for (expr * x : m_vars) {
+                s.assert_expr(a.mk_le(x, mk_num(4)));
+                s.assert_expr(a.mk_ge(x, mk_num(-4)));
+            }
+            s.assert_expr(m.mk_eq(mk_sum(), mk_num(1)));
+            check();
+            for (unsigned round = 0; round < 4; ++round) {
+                s.push();
+                assert_scope(s);
+                check();
+                if (m_rand(2) == 0) {
+                    s.push();
+                    assert_scope(s);
+                    check();
+                    s.pop(1);
+                    check();
+                }
+                s.pop(1);
+                check();
+            }
+            retracted += get_uint_stat(s, "arith-grobner-retracted");
+            return result;
+        }
+    };
+}
+
+void tst_nla_grobner() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    unsigned retracted = 0, num_checks = 0;
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        unsigned r = 0;
+        svector<lbool> off = nla_scopes(m, seed).run(false, false, r);
+        svector<lbool> on = nla_scopes(m, seed).run(true, false, retracted);
+        svector<lbool> toggled = nla_scopes(m, seed).run(true, true, r);
+        ENSURE(off.size() == on.size() && off.size() == toggled.size());
+        for (unsigned i = 0; i < off.size(); ++i) {
+            if (off[i] == l_undef)
+                continue;
+            ENSURE(on[i] == l_undef || on[i] == off[i]);
+            ENSURE(toggled[i] == l_undef || toggled[i] == off[i]);
+            ++num_checks;
+        }
+    }
+    std::cout << "checks: " << num_checks << " retracted: " << retracted << "\n";
+    ENSURE(retracted > 0);
+}
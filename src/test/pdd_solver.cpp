@@ -256,9 +256,50 @@ namespace dd {
         test_simplify(fmls, false);
         
     }
+
+    // equations are kept between saturations, those with dependencies are retracted
+    void test_resume() {
+        pdd_manager m(4);
+        u_dependency_manager dm;
+        reslimit lim;
+        pdd v0 = m.mk_var(0);
+        pdd v1 = m.mk_var(1);
+        pdd v2 = m.mk_var(2);
+        pdd v3 = m.mk_var(3);
+        solver gb(lim, dm, m);
+        auto has_dep = [](pdd const&, u_dependency* d) { return d != nullptr; };
+        auto is_conflict = [](solver::equation const* e) { return e->poly().is_val() && !e->poly().is_zero(); };
+
+        gb.add(v0*v1 - v2);
+        gb.add(v3 - 1, dm.mk_leaf(0));
+        gb.saturate();
+        gb.display(std::cout << "before retract\n");
+        unsigned sz = gb.equations().size();
+        ENSURE(gb.retract(has_dep) == 1);
+        ENSURE(gb.equations().size() == sz - 1);
+        for (auto* e : gb.equations())
+            ENSURE(!e->dep());
+
+        // a conflict is dropped when the saturation is resumed
+        gb.resume();
+        gb.add(v3 - 1, dm.mk_leaf(1));
+        gb.add(v3 - 2, dm.mk_leaf(2));
+        gb.saturate();
+        ENSURE(any_of(gb.equations(), is_conflict));
+        gb.resume();
+        ENSURE(!any_of(gb.equations(), is_conflict));
+        gb.add(v1 - 2);
+        gb.saturate();
+        gb.display(std::cout << "after resume\n");
+        ENSURE(!any_of(gb.equations(), is_conflict));
+        ENSURE(gb.retract(has_dep) > 0);
+        for (auto* e : gb.equations())
+            ENSURE(!e->dep());
+    }
 }
 
 void tst_pdd_solver() {
     dd::test1();
     dd::test2();
+    dd::test_resume();
 }
@@ -0,0 +1,117 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    qi_instance_cache.cpp
+
+Abstract:
+
+    The cache of simplified quantifier instances (smt.qi.instance_cache)
+    is kept across push/pop: instances that are recreated after a pop are
+    found in the cache, also when the roots of the bindings changed in
+    between, and the results are the same as without the cache.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/statistics.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <cstring>
+#include <iostream>
+
+static unsigned get_uint_stat(smt::kernel const & s, char const * key) {
+    statistics st;
+    s.collect_statistics(st);
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0 && st.is_uint(i))
+            r = st.get_uint_value(i);
+    return r;
+}
+
+namespace {
+    class cache_problem {
+        ast_manager &   m;
+        arith_util      a;
+        func_decl_ref   m_f;
+        expr_ref_vector m_cs;
+
+    public:
+        cache_problem(ast_manager & m): m(m), a(m), m_f(m), m_cs(m) {
+            sort * i = a.mk_int();
+            m_f = m.mk_func_decl(symbol("f"), i, i);
+            for (unsigned k = 0; k < 10; ++k)
+                m_cs.push_back(m.mk_const(symbol(("c" + std::to_string(k)).c_str()), i));
+        }
+
+        // forall x. f(x) > x
+        void assert_base(smt::kernel & s) {
+            sort * i = a.mk_int();
+            symbol x("x");
+            expr_ref v(m.mk_var(0, i), m);
+            expr_ref fx(m.mk_app(m_f, v.get()), m);
+            expr * pats[1] = { m.mk_pattern(to_app(fx.get())) };
+            s.assert_expr(m.mk_forall(1, &i, &x, a.mk_gt(fx, v), 0, symbol::null, symbol::null, 1, pats));
+        }
+
+        // f(c0) + ... + f(c9) <= c0 + ... + c9 + 9, every instance is needed for unsat.
+        // In odd rounds two of the constants are equal.
+        void assert_round(smt::kernel & s, unsigned round) {
+            expr_ref_vector fs(m);
+            for (expr * c : m_cs)
+                fs.push_back(m.mk_app(m_f, c));
+            s.assert_expr(a.mk_le(a.mk_add(fs.size(), fs.data()), a.mk_add(a.mk_add(m_cs.size(), m_cs.data()), a.mk_int(9))));
+            if (round % 2 == 1)
+                s.assert_expr(m.mk_eq(m_cs.get(round % m_cs.size()), m_cs.get((round + 3) % m_cs.size())));
+        }
+
+        /**
+           \brief Check the rounds in one context, add the cache hits and misses after the first round.
+        */
+        void run(unsigned cache_size, svector<lbool> & results, unsigned & hits, unsigned & misses) {
+            smt_params fp;
+            fp.m_auto_config = false;
+            fp.m_mbqi = false;
+            fp.m_qi_instance_cache = cache_size;
+            smt::kernel s(m, fp);
+            assert_base(s);
+            unsigned hits0 = 0, misses0 = 0;
+            for (unsigned round = 0; round < 20; ++round) {
+                s.push();
+                assert_round(s, round);
+                results.push_back(s.check());
+                s.pop(1);
+                if (round == 0) {
+                    hits0 = get_uint_stat(s, "quant instance cache hits");
+                    misses0 = get_uint_stat(s, "quant instance cache misses");
+                }
+            }
+            hits += get_uint_stat(s, "quant instance cache hits") - hits0;
+            misses += get_uint_stat(s, "quant instance cache misses") - misses0;
+        }
+    };
+}
+
+void tst_qi_instance_cache() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cache_problem p(m);
+    svector<lbool> uncached, cached;
+    unsigned hits = 0, misses = 0;
+    p.run(0, uncached, hits, misses);
+    ENSURE(hits == 0 && misses == 0);
+    p.run(16, cached, hits, misses);
+    ENSURE(uncached == cached);
+    for (lbool r : cached)
+        ENSURE(r == l_false);
+    std::cout << "hits: " << hits << " misses: " << misses << "\n";
+    // the instances of later rounds are the instances of the first round,
+    // only merges of the roots in odd rounds cause misses.
+    ENSURE(hits > 0);
+    ENSURE(hits >= 4 * misses);
+}
@@ -0,0 +1,85 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_bva.cpp
+
+Abstract:
+
+    Bounded variable addition on clause sets with duplicate clauses.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "sat/sat_bva.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <initializer_list>
+#include <iostream>
+
+static void add_clause(sat::solver & s, vector<sat::literal_vector> & cls, std::initializer_list<sat::literal> c) {
+    cls.push_back(sat::literal_vector());
+    for (sat::literal l : c)
+        cls.back().push_back(l);
+    s.mk_clause(cls.back().size(), cls.back().data());
+}
+
+/**
+   \brief Run bounded variable addition on s, check that the number of removed clauses
+   is the reported reduction and that a model of the result satisfies the clauses cls.
+*/
+static void check_bva(sat::solver & s, vector<sat::literal_vector> const & cls, unsigned expected_vars) {
+    unsigned num_clauses = s.num_clauses();
+    sat::bva b(s);
+    b(10000000);
+    std::cout << "bva vars: " << b.num_vars_added() << " reduced: " << b.num_reduced()
+              << " clauses: " << num_clauses << " -> " << s.num_clauses() << "\n";
+    ENSURE(b.num_vars_added() == expected_vars);
+    ENSURE(num_clauses - s.num_clauses() == b.num_reduced());
+    ENSURE(s.check() == l_true);
+    for (auto const & c : cls) {
+        bool sat = false;
+        for (sat::literal l : c)
+            sat |= s.get_model()[l.var()] == (l.sign() ? l_false : l_true);
+        ENSURE(sat);
+    }
+}
+
+// a | c | d three times and b | c | d: the duplicates do not make a reduction.
+static void tst_duplicates_only() {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    vector<sat::literal_vector> cls;
+    sat::literal a(s.mk_var(), false), b(s.mk_var(), false), c(s.mk_var(), false), d(s.mk_var(), false);
+    for (unsigned i = 0; i < 3; ++i)
+        add_clause(s, cls, { a, c, d });
+    add_clause(s, cls, { b, c, d });
+    check_bva(s, cls, 0);
+}
+
+// x_i | y_j | z_j for i, j < 4, and the clauses with x_0 twice.
+static void tst_product_with_duplicates() {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    vector<sat::literal_vector> cls;
+    sat::literal_vector xs, ys, zs;
+    for (unsigned i = 0; i < 4; ++i) {
+        xs.push_back(sat::literal(s.mk_var(), false));
+        ys.push_back(sat::literal(s.mk_var(), false));
+        zs.push_back(sat::literal(s.mk_var(), true));
+    }
+    for (unsigned i = 0; i < 4; ++i)
+        for (unsigned j = 0; j < 4; ++j)
+            for (unsigned k = 0; k < (i == 0 ? 2u : 1u); ++k)
+                add_clause(s, cls, { xs[i], ys[j], zs[j] });
+    // the remaining copies of x_0 | y_j | z_j are reduced with the first fresh variable.
+    check_bva(s, cls, 2);
+}
+
+void tst_sat_bva() {
+    tst_duplicates_only();
+    tst_product_with_duplicates();
+}
@@ -0,0 +1,79 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_clause_allocator.cpp
+
+Abstract:
+
+    Test the offset-addressed clause arena and watch encoding.
+
+--*/
+
+#include "sat/sat_clause.h"
+#include "sat/sat_watched.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <iostream>
+
+static void check_clause(sat::clause const& c, sat::literal_vector const& lits) {
+    ENSURE(c.size() == lits.size());
+    for (unsigned i = 0; i < lits.size(); ++i)
+        ENSURE(c[i] == lits[i]);
+}
+
+void tst_sat_clause_allocator() {
+    random_gen r(0);
+    sat::clause_allocator alloc;
+    ptr_vector<sat::clause> clauses;
+    vector<sat::literal_vector> lits;
+
+    // mix of small, medium and large clauses, the large ones exceed the inline object size.
+    for (unsigned i = 0; i < 20000; ++i) {
+        unsigned sz = 3 + (i % 97 == 0 ? 200 + r(300) : r(20));
+        sat::literal_vector ls;
+        for (unsigned j = 0; j < sz; ++j)
+            ls.push_back(sat::literal(r(1000), r(2) == 0));
+        clauses.push_back(alloc.mk_clause(ls.size(), ls.data(), r(2) == 0));
+        lits.push_back(ls);
+    }
+    for (unsigned i = 0; i < clauses.size(); ++i) {
+        sat::clause_offset off = alloc.get_offset(clauses[i]);
+        ENSURE(alloc.get_clause(off) == clauses[i]);
+        check_clause(*clauses[i], lits[i]);
+        sat::watched w(lits[i][0], off);
+        ENSURE(w.get_clause_offset() == off);
+        ENSURE(w.get_blocked_literal() == lits[i][0]);
+    }
+
+    // release every other clause and allocate replacements that reuse the released cells.
+    for (unsigned i = 0; i < clauses.size(); i += 2) {
+        alloc.del_clause(clauses[i]);
+        lits[i].reverse();
+        clauses[i] = alloc.mk_clause(lits[i].size(), lits[i].data(), false);
+    }
+    for (unsigned i = 0; i < clauses.size(); ++i) {
+        ENSURE(alloc.get_clause(alloc.get_offset(clauses[i])) == clauses[i]);
+        check_clause(*clauses[i], lits[i]);
+    }
+
+    // compacting copy into a fresh arena.
+    sat::clause_allocator alloc2;
+    for (unsigned i = 0; i < clauses.size(); ++i) {
+        sat::clause* c = alloc2.copy_clause(*clauses[i]);
+        alloc.del_clause(clauses[i]);
+        clauses[i] = c;
+    }
+    ENSURE(alloc.get_allocation_size() == 0);
+    for (unsigned i = 0; i < clauses.size(); ++i) {
+        ENSURE(alloc2.get_clause(alloc2.get_offset(clauses[i])) == clauses[i]);
+        check_clause(*clauses[i], lits[i]);
+    }
+    alloc2.finalize();
+
+    sat::watched ext(static_cast<sat::ext_constraint_idx>(0x12345678abcdull));
+    ENSURE(ext.is_ext_constraint());
+    ENSURE(ext.get_ext_constraint_idx() == static_cast<sat::ext_constraint_idx>(0x12345678abcdull));
+    std::cout << "sat clause allocator ok\n";
+}
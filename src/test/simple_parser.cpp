@@ -25,6 +25,41 @@ Revision History:
 #include "parsers/util/cost_parser.h"
 
 
+static void tst_compiled_cost() {
+    ast_manager    m;
+    reg_decl_plugins(m);
+    cost_parser    p(m);
+    cost_evaluator eval(m);
+    p.add_var("x");
+    p.add_var("y");
+    char const * fmls[] = {
+        "(+ x (* y x))",
+        "(+ x (* 10 y) 2)",
+        "(- x (* y 2))",
+        "(/ x y)",
+        "(/ (+ x 1) (- y 3))",
+        "(ite (and (> x 3) (<= y 4))  2 10)",
+        "(ite (or (> x 3) (<= y 4))  2 10)",
+        "(ite (and (< x y) (>= y 2) (not (= x y))) (* x 2) (+ y 1))",
+        "(ite (or (= x 0) (= y 0) (> x y)) x y)",
+        "(ite (implies (> x 1) (< y 2)) 7 9)",
+        "(ite (xor (> x 1) (< y 2)) 7 9)",
+    };
+    float vals[][2] = { { 2.0f, 3.0f }, { 0.0f, 0.0f }, { 5.0f, 1.0f }, { 4.0f, 4.0f }, { -1.0f, 3.0f } };
+    cost_evaluator::program prog;
+    for (char const * s : fmls) {
+        expr_ref r(m);
+        ENSURE(p.parse_string(s, r));
+        eval.compile(r, prog);
+        for (auto const & v : vals) {
+            float expected = eval(r, 2, v);
+            float actual   = eval(prog, 2, v);
+            TRACE(simple_parser, tout << s << " " << v[0] << " " << v[1] << ": " << expected << " " << actual << "\n";);
+            ENSURE(expected == actual);
+        }
+    }
+}
+
 void tst_simple_parser() {
     ast_manager    m;
     reg_decl_plugins(m);
@@ -60,5 +95,5 @@ void tst_simple_parser() {
     TRACE(simple_parser, 
           tout << mk_pp(r, m) << "\n";
           tout << "val: " << eval(r, 2, vals) << "\n";);
+    tst_compiled_cost();
 }
-
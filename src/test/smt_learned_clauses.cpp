@@ -0,0 +1,141 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_learned_clauses.cpp
+
+Abstract:
+
+    Round trip of learned clauses through Z3_solver_export_learned
+    and Z3_solver_import_learned.
+
+--*/
+
+#include "api/z3.h"
+#include "smt/smt_learned_clauses.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+   \brief Assert random 3-SAT clauses that are satisfied by a planted assignment.
+   The instance is satisfiable, but the solver needs conflicts to find a model.
+   The same clauses are created for every context.
+*/
+static void assert_planted_3sat(Z3_context ctx, Z3_solver s) {
+    unsigned const num_vars = 120, num_clauses = 510;
+    random_gen r(0);
+    Z3_sort bool_sort = Z3_mk_bool_sort(ctx);
+    std::vector<Z3_ast> vars;
+    std::vector<bool> planted;
+    for (unsigned i = 0; i < num_vars; ++i) {
+        std::string name = "p" + std::to_string(i);
+        vars.push_back(Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, name.c_str()), bool_sort));
+        planted.push_back(r(2) == 0);
+    }
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        unsigned v[3];
+        bool sign[3];
+        do {
+            for (unsigned j = 0; j < 3; ++j) {
+                v[j] = r(num_vars);
+                sign[j] = r(2) == 0;
+            }
+        }
+        while (sign[0] == planted[v[0]] && sign[1] == planted[v[1]] && sign[2] == planted[v[2]]);
+        Z3_ast lits[3];
+        for (unsigned j = 0; j < 3; ++j)
+            lits[j] = sign[j] ? Z3_mk_not(ctx, vars[v[j]]) : vars[v[j]];
+        Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 3, lits));
+    }
+}
+
+static unsigned get_uint_stat(Z3_context ctx, Z3_solver s, char const * key) {
+    Z3_stats st = Z3_solver_get_statistics(ctx, s);
+    Z3_stats_inc_ref(ctx, st);
+    unsigned r = 0;
+    for (unsigned i = 0; i < Z3_stats_size(ctx, st); ++i)
+        if (strcmp(Z3_stats_get_key(ctx, st, i), key) == 0 && Z3_stats_is_uint(ctx, st, i))
+            r = Z3_stats_get_uint_value(ctx, st, i);
+    Z3_stats_dec_ref(ctx, st);
+    return r;
+}
+
+static Z3_solver mk_solver(Z3_context ctx) {
+    Z3_solver s = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    assert_planted_3sat(ctx, s);
+    return s;
+}
+
+void tst_smt_learned_clauses() {
+    char const * file = "tst_smt_learned_clauses.lc";
+    Z3_config cfg = Z3_mk_config();
+
+    // export from a solver that has learned clauses.
+    Z3_context ctx1 = Z3_mk_context(cfg);
+    Z3_set_error_handler(ctx1, nullptr);
+    Z3_solver s1 = mk_solver(ctx1);
+    ENSURE(Z3_solver_check(ctx1, s1) == Z3_L_TRUE);
+    Z3_solver_export_learned(ctx1, s1, file);
+    ENSURE(Z3_get_error_code(ctx1) == Z3_OK);
+
+    smt::learned_clauses lc;
+    {
+        std::ifstream in(file, std::ios::binary);
+        ENSURE(lc.read(in));
+    }
+    std::cout << "atoms: " << lc.m_atoms.size() << " clauses: " << lc.m_clauses.size() << "\n";
+    ENSURE(!lc.m_atoms.empty());
+    ENSURE(!lc.m_clauses.empty());
+    for (auto const & c : lc.m_clauses)
+        for (unsigned lit : c)
+            ENSURE((lit >> 1) < lc.m_atoms.size());
+
+    // the binary format round trips.
+    {
+        std::stringstream strm;
+        lc.write(strm);
+        smt::learned_clauses lc2;
+        ENSURE(lc2.read(strm));
+        ENSURE(lc2.m_atoms.size() == lc.m_atoms.size());
+        for (unsigned i = 0; i < lc.m_atoms.size(); ++i) {
+            ENSURE(lc2.m_atoms[i].m_hash == lc.m_atoms[i].m_hash);
+            ENSURE(lc2.m_atoms[i].m_text == lc.m_atoms[i].m_text);
+            ENSURE(lc2.m_atoms[i].m_activity == lc.m_atoms[i].m_activity);
+            ENSURE(lc2.m_atoms[i].m_phase == lc.m_atoms[i].m_phase);
+        }
+        ENSURE(lc2.m_clauses == lc.m_clauses);
+    }
+
+    // import into a fresh solver with the same assertions in a different context.
+    // All atoms are known to the new solver, so every clause is added.
+    Z3_context ctx2 = Z3_mk_context(cfg);
+    Z3_set_error_handler(ctx2, nullptr);
+    Z3_solver s2 = mk_solver(ctx2);
+    Z3_solver_import_learned(ctx2, s2, file);
+    ENSURE(Z3_get_error_code(ctx2) == Z3_OK);
+    ENSURE(Z3_solver_check(ctx2, s2) == Z3_L_TRUE);
+    ENSURE(get_uint_stat(ctx2, s2, "imported clauses") == lc.m_clauses.size());
+
+    // the import is rejected when there are user scopes.
+    Z3_solver s3 = mk_solver(ctx2);
+    Z3_solver_push(ctx2, s3);
+    Z3_solver_import_learned(ctx2, s3, file);
+    ENSURE(Z3_get_error_code(ctx2) != Z3_OK);
+
+    Z3_solver_dec_ref(ctx2, s3);
+    Z3_solver_dec_ref(ctx2, s2);
+    Z3_solver_dec_ref(ctx1, s1);
+    Z3_del_context(ctx2);
+    Z3_del_context(ctx1);
+    Z3_del_config(cfg);
+    std::remove(file);
+}
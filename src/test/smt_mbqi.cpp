@@ -0,0 +1,137 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_mbqi.cpp
+
+Abstract:
+
+    Model based quantifier instantiation with smt.mbqi.threads > 1
+    gives the same results as with one thread, over several rounds
+    of model checking and several checks of the same context, and
+    is interrupted cleanly when the resource limit is exhausted.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/rlimit.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <iostream>
+
+namespace {
+    class mbqi_problems {
+        ast_manager & m;
+        arith_util    a;
+        sort *        m_int;
+        func_decl_ref m_f, m_g, m_p, m_q, m_r;
+        expr_ref      m_c;
+
+        expr_ref forall(expr * body) {
+            sort * s = m_int;
+            symbol x("x");
+            return expr_ref(m.mk_forall(1, &s, &x, body), m);
+        }
+
+        expr_ref var() { return expr_ref(m.mk_var(0, m_int), m); }
+        expr_ref num(int n) { return expr_ref(a.mk_int(n), m); }
+
+    public:
+        mbqi_problems(ast_manager & m): m(m), a(m), m_int(a.mk_int()), m_f(m), m_g(m), m_p(m), m_q(m), m_r(m), m_c(m) {
+            m_f = m.mk_func_decl(symbol("f"), m_int, m_int);
+            m_g = m.mk_func_decl(symbol("g"), m_int, m_int);
+            m_p = m.mk_func_decl(symbol("p"), m_int, m.mk_bool_sort());
+            m_q = m.mk_func_decl(symbol("q"), m_int, m.mk_bool_sort());
+            m_r = m.mk_func_decl(symbol("r"), m_int, m.mk_bool_sort());
+            m_c = m.mk_const(symbol("c"), m_int);
+        }
+
+        // forall x. f(x) >= 0, forall x. g(x) = f(x) + 1, forall x. x > 5 => f(x) > 5, and p, q, r
+        void assert_base(smt::kernel & s) {
+            expr_ref x = var();
+            s.assert_expr(forall(a.mk_ge(m.mk_app(m_f, x.get()), num(0))));
+            s.assert_expr(forall(m.mk_eq(m.mk_app(m_g, x.get()), a.mk_add(m.mk_app(m_f, x.get()), num(1)))));
+            s.assert_expr(forall(m.mk_or(m.mk_app(m_p, x.get()), m.mk_app(m_q, x.get()))));
+            s.assert_expr(forall(m.mk_or(m.mk_not(m.mk_app(m_p, x.get())), m.mk_app(m_r, x.get()))));
+            s.assert_expr(forall(m.mk_implies(a.mk_gt(x, num(5)), a.mk_gt(m.mk_app(m_f, x.get()), num(5)))));
+        }
+
+        // scopes that are satisfiable or not on top of the base, with the expected result.
+        lbool assert_scope(smt::kernel & s, unsigned i) {
+            expr_ref fc(m.mk_app(m_f, m_c.get()), m), gc(m.mk_app(m_g, m_c.get()), m);
+            switch (i) {
+            case 0:
+                s.assert_expr(a.mk_lt(gc, num(1)));
+                return l_false;
+            case 1:
+                s.assert_expr(m.mk_eq(fc, num(3)));
+                s.assert_expr(m.mk_eq(a.mk_add(gc, m.mk_app(m_g, gc.get())), num(9)));
+                return l_true;
+            case 2:
+                s.assert_expr(m.mk_not(m.mk_app(m_r, m_c.get())));
+                s.assert_expr(m.mk_not(m.mk_app(m_q, m_c.get())));
+                return l_false;
+            case 3:
+                s.assert_expr(m.mk_not(m.mk_app(m_r, m_c.get())));
+                s.assert_expr(a.mk_gt(m_c, num(7)));
+                return l_true;
+            default:
+                s.assert_expr(a.mk_gt(m_c, num(7)));
+                s.assert_expr(a.mk_le(fc, num(5)));
+                return l_false;
+            }
+        }
+
+        /**
+           \brief Check every scope in one context with the given number of threads.
+           If rlimit is not 0, checks may stop with l_undef or an exception, otherwise the results are expected.
+        */
+        void run(unsigned threads, unsigned rlimit, svector<lbool> & results) {
+            smt_params fp;
+            fp.m_mbqi_threads = threads;
+            smt::kernel s(m, fp);
+            assert_base(s);
+            for (unsigned i = 0; i < 5; ++i) {
+                s.push();
+                lbool expected = assert_scope(s, i);
+                lbool r;
+                try {
+                    scoped_rlimit _rl(m.limit(), rlimit);
+                    r = s.check();
+                }
+                catch (z3_exception &) {
+                    // the rewriters throw when the limit is exhausted, also inside the workers.
+                    ENSURE(rlimit > 0);
+                    r = l_undef;
+                }
+                ENSURE(r == expected || (rlimit > 0 && r == l_undef));
+                results.push_back(r);
+                s.pop(1);
+            }
+        }
+    };
+}
+
+void tst_smt_mbqi() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    mbqi_problems p(m);
+    svector<lbool> sequential, parallel;
+    p.run(1, 0, sequential);
+    p.run(4, 0, parallel);
+    ENSURE(sequential == parallel);
+    // exhaust the resource limit at different points of the search, also inside the workers
+    unsigned num_undef = 0;
+    for (unsigned rlimit = 100; rlimit < 100000; rlimit *= 3) {
+        svector<lbool> results;
+        p.run(4, rlimit, results);
+        for (lbool r : results)
+            num_undef += r == l_undef;
+    }
+    std::cout << "undef results with resource limits: " << num_undef << "\n";
+    ENSURE(num_undef > 0);
+}
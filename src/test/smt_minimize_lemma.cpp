@@ -0,0 +1,105 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_minimize_lemma.cpp
+
+Abstract:
+
+    The cache of failed redundancy checks in lemma minimization
+    does not change the minimized lemmas. Random problems over
+    equalities of uninterpreted terms are solved with the cache
+    on and off, and the learned lemmas are compared.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_pp.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/statistics.h"
+#include "util/rlimit.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+static unsigned get_uint_stat(smt::kernel const & s, char const * key) {
+    statistics st;
+    s.collect_statistics(st);
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0 && st.is_uint(i))
+            r = st.get_uint_value(i);
+    return r;
+}
+
+/**
+   \brief Random clauses over the atoms x_i = x_j and f(x_i) = x_j.
+*/
+static void mk_problem(ast_manager & m, unsigned seed, expr_ref_vector & fmls) {
+    random_gen r(seed);
+    sort * s = m.mk_uninterpreted_sort(symbol("S"));
+    func_decl * f = m.mk_func_decl(symbol("f"), s, s);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i < 8; ++i)
+        xs.push_back(m.mk_const(symbol(("x" + std::to_string(i)).c_str()), s));
+    for (unsigned k = 0; k < 120; ++k) {
+        expr_ref_vector lits(m);
+        for (unsigned l = 0; l < 3; ++l) {
+            expr * x = xs.get(r(xs.size()));
+            expr * y = xs.get(r(xs.size()));
+            expr_ref lit(m.mk_eq(r(2) == 0 ? x : m.mk_app(f, x), y), m);
+            lits.push_back(r(2) == 0 ? m.mk_not(lit) : lit.get());
+        }
+        fmls.push_back(m.mk_or(lits));
+    }
+}
+
+/**
+   \brief Solve the problem of seed and return the lemmas that were learned, in order.
+   Each run uses its own manager, so the runs create the same expressions in the same order.
+*/
+static std::string solve(unsigned seed, bool cache, unsigned & cache_hits, lbool & result) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector fmls(m);
+    mk_problem(m, seed, fmls);
+    smt_params fp;
+    fp.m_minimize_cache = cache;
+    smt::kernel s(m, fp);
+    std::ostringstream lemmas;
+    user_propagator::on_clause_eh_t on_clause = [&](void *, expr * proof, unsigned, unsigned const *, unsigned n, expr * const * lits) {
+        for (unsigned i = 0; i < n; ++i)
+            lemmas << mk_pp(lits[i], m) << " ";
+        lemmas << "\n";
+    };
+    s.register_on_clause(nullptr, on_clause);
+    for (expr * f : fmls)
+        s.assert_expr(f);
+    {
+        scoped_rlimit _rl(m.limit(), 1000000);
+        result = s.check();
+    }
+    cache_hits += get_uint_stat(s, "minimize cache hits");
+    return lemmas.str();
+}
+
+void tst_smt_minimize_lemma() {
+    unsigned cache_hits = 0, num_lemmas = 0;
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        unsigned hits_off = 0;
+        lbool r_off, r_on;
+        std::string off = solve(seed, false, hits_off, r_off);
+        std::string on = solve(seed, true, cache_hits, r_on);
+        ENSURE(hits_off == 0);
+        ENSURE(r_off == r_on);
+        ENSURE(off == on);
+        num_lemmas += static_cast<unsigned>(std::count(on.begin(), on.end(), '\n'));
+    }
+    std::cout << "lemmas: " << num_lemmas << " cache hits: " << cache_hits << "\n";
+    ENSURE(cache_hits > 0);
+}
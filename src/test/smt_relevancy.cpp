@@ -0,0 +1,140 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_relevancy.cpp
+
+Abstract:
+
+    Relevancy with the watches of Boolean gates installed lazily
+    (smt.relevancy=3) marks the same expressions as relevant as
+    relevancy with the watches installed at internalization
+    (smt.relevancy=2). The atoms of random formulas are fixed by
+    assumptions, so both contexts reach the same assignment.
+
+--*/
+
+#include "smt/smt_context.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/for_each_expr.h"
+#include "util/statistics.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <cstring>
+#include <iostream>
+
+namespace {
+    class relevancy_problem {
+        ast_manager &   m;
+        random_gen      m_rand;
+        expr_ref_vector m_atoms;
+        bool_vector     m_values;
+        expr_ref_vector m_fmls;
+
+        expr_ref mk_gate(unsigned depth, bool & val) {
+            if (depth == 0 || m_rand(4) == 0) {
+                unsigned i = m_rand(m_atoms.size());
+                val = m_values[i];
+                return expr_ref(m_atoms.get(i), m);
+            }
+            bool v1, v2, v3;
+            expr_ref a = mk_gate(depth - 1, v1);
+            expr_ref b = mk_gate(depth - 1, v2);
+            switch (m_rand(4)) {
+            case 0:
+                val = !v1;
+                return expr_ref(m.mk_not(a), m);
+            case 1: {
+                expr_ref c = mk_gate(depth - 1, v3);
+                val = v1 && v2 && v3;
+                return expr_ref(m.mk_and(a, b, c), m);
+            }
+            case 2: {
+                expr_ref c = mk_gate(depth - 1, v3);
+                val = v1 || v2 || v3;
+                return expr_ref(m.mk_or(a, b, c), m);
+            }
+            default:
+                val = !v1 || v2;
+                return expr_ref(m.mk_implies(a, b), m);
+            }
+        }
+
+    public:
+        relevancy_problem(ast_manager & m, unsigned seed):
+            m(m), m_rand(seed), m_atoms(m), m_fmls(m) {
+            sort * s = m.mk_uninterpreted_sort(symbol("S"));
+            func_decl * q = m.mk_func_decl(symbol("q"), s, m.mk_bool_sort());
+            for (unsigned i = 0; i < 6; ++i) {
+                m_atoms.push_back(m.mk_const(symbol(("p" + std::to_string(i)).c_str()), m.mk_bool_sort()));
+                expr * x = m.mk_const(symbol(("x" + std::to_string(i)).c_str()), s);
+                m_atoms.push_back(m.mk_app(q, x));
+            }
+            for (unsigned i = 0; i < m_atoms.size(); ++i)
+                m_values.push_back(m_rand(2) == 0);
+            for (unsigned i = 0; i < 8; ++i) {
+                bool val;
+                expr_ref f = mk_gate(3, val);
+                m_fmls.push_back(val ? f.get() : m.mk_not(f));
+            }
+        }
+
+        /**
+           \brief Solve the formulas at the given relevancy level, with the atoms fixed by assumptions.
+           Set relevant to the relevancy of every sub-expression of the preprocessed formulas.
+        */
+        void solve(unsigned relevancy_lvl, bool_vector & relevant, unsigned & lazy_watches) {
+            smt_params fp;
+            fp.m_auto_config = false;
+            fp.m_relevancy_lvl = relevancy_lvl;
+            smt::context ctx(m, fp);
+            for (expr * f : m_fmls)
+                ctx.assert_expr(f);
+            expr_ref_vector assumptions(m);
+            for (unsigned i = 0; i < m_atoms.size(); ++i)
+                assumptions.push_back(m_values[i] ? m_atoms.get(i) : m.mk_not(m_atoms.get(i)));
+            ENSURE(ctx.check(assumptions.size(), assumptions.data()) == l_true);
+            relevant.reset();
+            ptr_vector<expr> fmls;
+            ctx.get_asserted_formulas(fmls);
+            expr_mark visited;
+            for (expr * f : fmls)
+                for (expr * e : subterms::all(expr_ref(f, m), nullptr, &visited))
+                    relevant.push_back(ctx.is_relevant(e));
+            statistics st;
+            ctx.collect_statistics(st);
+            for (unsigned i = 0; i < st.size(); ++i)
+                if (strcmp(st.get_key(i), "relevancy lazy watches") == 0 && st.is_uint(i))
+                    lazy_watches += st.get_uint_value(i);
+        }
+    };
+}
+
+/**
+   \brief Each level uses its own manager, so both contexts create the same expressions in the same order.
+*/
+static void solve(unsigned seed, unsigned relevancy_lvl, bool_vector & relevant, unsigned & lazy_watches) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    relevancy_problem p(m, seed);
+    p.solve(relevancy_lvl, relevant, lazy_watches);
+}
+
+void tst_smt_relevancy() {
+    unsigned lazy_watches = 0, num_relevant = 0, num_irrelevant = 0;
+    for (unsigned seed = 0; seed < 50; ++seed) {
+        bool_vector eager, lazy;
+        unsigned eager_watches = 0;
+        solve(seed, 2, eager, eager_watches);
+        solve(seed, 3, lazy, lazy_watches);
+        ENSURE(eager_watches == 0);
+        ENSURE(eager == lazy);
+        for (bool r : eager)
+            ++(r ? num_relevant : num_irrelevant);
+    }
+    std::cout << "relevant: " << num_relevant << " irrelevant: " << num_irrelevant
+              << " lazy watches: " << lazy_watches << "\n";
+    ENSURE(lazy_watches > 0);
+    ENSURE(num_irrelevant > 0);
+}